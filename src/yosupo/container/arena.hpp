@@ -0,0 +1,72 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace yosupo {
+
+// Node storage addressed by int ids
+// Nodes are allocated in chunks of 2^LOG and never move, freed ids are reused
+template <class T, int LOG = 12> struct NodeArena {
+    static_assert(0 < LOG && LOG < 31);
+
+    NodeArena() = default;
+    NodeArena(const NodeArena& other)
+        : used(other.used), free_ids(other.free_ids) {
+        for (const auto& c : other.chunks) {
+            chunks.push_back(std::make_unique<T[]>(size_t(1) << LOG));
+            std::copy(c.get(), c.get() + (1 << LOG), chunks.back().get());
+        }
+    }
+    NodeArena(NodeArena&&) = default;
+    NodeArena& operator=(const NodeArena& other) {
+        if (this != &other) *this = NodeArena(other);
+        return *this;
+    }
+    NodeArena& operator=(NodeArena&&) = default;
+
+    int alloc(const T& x) {
+        int id;
+        if (!free_ids.empty()) {
+            id = free_ids.back();
+            free_ids.pop_back();
+        } else {
+            if (used == (std::ssize(chunks) << LOG)) {
+                chunks.push_back(std::make_unique<T[]>(size_t(1) << LOG));
+            }
+            id = int(used++);
+        }
+        (*this)[id] = x;
+        return id;
+    }
+
+    void free(int id) {
+        assert(0 <= id && id < used);
+        free_ids.push_back(id);
+    }
+
+    T& operator[](int id) { return chunks[id >> LOG][id & MASK]; }
+    const T& operator[](int id) const { return chunks[id >> LOG][id & MASK]; }
+
+    // number of live nodes
+    size_t size() const { return used - std::ssize(free_ids); }
+    size_t capacity() const { return chunks.size() << LOG; }
+
+    // free all nodes, keeping the allocated chunks
+    void clear() {
+        used = 0;
+        free_ids.clear();
+    }
+
+  private:
+    static constexpr int MASK = (1 << LOG) - 1;
+
+    std::vector<std::unique_ptr<T[]>> chunks;
+    ptrdiff_t used = 0;
+    std::vector<int> free_ids;
+};
+
+}  // namespace yosupo
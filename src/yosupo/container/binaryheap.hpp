@@ -9,9 +9,13 @@
 
 namespace yosupo {
 
-template <class T, class Comp = std::less<T>> struct MeldableBinaryHeapManager {
+// D-ary heap, D = 4 or 8 keeps the children of a node in one cache line
+template <class T, class Comp = std::less<T>, int D = 2>
+struct MeldableDaryHeapManager {
+    static_assert(D >= 2);
+
     Comp comp;
-    MeldableBinaryHeapManager(const Comp& _comp = Comp()) : comp(_comp) {}
+    MeldableDaryHeapManager(const Comp& _comp = Comp()) : comp(_comp) {}
 
     struct Heap {
         std::vector<T> d;
@@ -25,7 +29,7 @@ template <class T, class Comp = std::less<T>> struct MeldableBinaryHeapManager {
     Heap build(std::vector<T> d) {
         ssize_t n = std::ssize(d);
         auto h = Heap{std::move(d)};
-        for (ssize_t i = n / 2 - 1; i >= 0; i--) {
+        for (ssize_t i = (n - 2) / D; i >= 0; i--) {
             down(h, i);
         }
         return h;
@@ -35,7 +39,7 @@ template <class T, class Comp = std::less<T>> struct MeldableBinaryHeapManager {
         ssize_t c = std::ssize(h);
         h.d.push_back(x);
         while (c > 0) {
-            ssize_t p = (c - 1) / 2;
+            ssize_t p = (c - 1) / D;
             if (!bool(comp(h.d[p], h.d[c]))) break;
             std::swap(h.d[p], h.d[c]);
             c = p;
@@ -70,8 +74,8 @@ template <class T, class Comp = std::less<T>> struct MeldableBinaryHeapManager {
             h.d.insert(h.d.end(), other.d.begin(), other.d.end());
 
             while (l) {
-                l = (l - 1) / 2;
-                r = (r - 1) / 2;
+                l = (l - 1) / D;
+                r = (r - 1) / D;
                 for (ssize_t i = r; i >= l; i--) {
                     down(h, i);
                 }
@@ -85,9 +89,11 @@ template <class T, class Comp = std::less<T>> struct MeldableBinaryHeapManager {
   private:
     void down(Heap& h, ssize_t u) {
         ssize_t n = std::ssize(h);
-        while (2 * u + 1 < n) {
-            ssize_t v = (2 * u + 1);
-            if (v + 1 < n && comp(h.d[v], h.d[v + 1])) v++;
+        while (D * u + 1 < n) {
+            ssize_t v = D * u + 1, end = std::min(n, v + D);
+            for (ssize_t w = v + 1; w < end; w++) {
+                if (comp(h.d[v], h.d[w])) v = w;
+            }
             if (!comp(h.d[u], h.d[v])) break;
             std::swap(h.d[u], h.d[v]);
             u = v;
@@ -95,4 +101,7 @@ template <class T, class Comp = std::less<T>> struct MeldableBinaryHeapManager {
     }
 };
 
+template <class T, class Comp = std::less<T>>
+using MeldableBinaryHeapManager = MeldableDaryHeapManager<T, Comp, 2>;
+
 }  // namespace yosupo
@@ -5,8 +5,11 @@
 #include <cassert>
 #include <cstddef>
 #include <functional>
+#include <utility>
 #include <vector>
 
+#include "yosupo/types.hpp"
+
 namespace yosupo {
 
 struct BitVec {
@@ -55,6 +58,29 @@ struct BitVec {
         }
         return int(size());
     }
+    // @return min j >= i s.t. a[j] = 1, or size()
+    int find_next(size_t i) const {
+        if (i >= n) return int(size());
+        size_t w = i / B;
+        unsigned long long x = d[w] & (-1ULL << (i % B));
+        while (!x) {
+            if (++w == d.size()) return int(size());
+            x = d[w];
+        }
+        return int(w * B + std::countr_zero(x));
+    }
+    // #{l <= i < r | a[i] = 1}
+    size_t count_range(size_t l, size_t r) const {
+        assert(l <= r && r <= n);
+        if (l == r) return 0;
+        size_t lw = l / B, rw = (r - 1) / B;
+        unsigned long long lm = -1ULL << (l % B);
+        unsigned long long rm = -1ULL >> (B - 1 - (r - 1) % B);
+        if (lw == rw) return std::popcount(d[lw] & lm & rm);
+        size_t sm = std::popcount(d[lw] & lm) + std::popcount(d[rw] & rm);
+        for (size_t i = lw + 1; i < rw; i++) sm += std::popcount(d[i]);
+        return sm;
+    }
 
     BitVec& flip() {
         op1(std::bit_not<unsigned long long>());
@@ -107,6 +133,28 @@ struct BitVec {
         fill(d.begin() + d.size() - block, d.end(), 0ULL);
         return *this;
     }
+    // *this |= r << s, without a temporary. r may be *this
+    BitVec& or_shifted(const BitVec& r, size_t s) {
+        assert(n == r.n);
+        auto block = s / B, rem = s % B;
+        if (d.size() <= block) return *this;
+        unsigned long long* x = d.data();
+        const unsigned long long* y = r.d.data();
+        // descending, so that y[j] (j < i) is read before it is updated
+        if (rem == 0) {
+            for (size_t i = d.size() - 1; i >= block + 1; i--) {
+                x[i] |= y[i - block];
+            }
+        } else {
+            for (size_t i = d.size() - 1; i >= block + 1; i--) {
+                x[i] |= y[i - block] << rem | y[i - block - 1] >> (B - rem);
+            }
+        }
+        x[block] |= y[0] << rem;
+        erase_last();
+        return *this;
+    }
+
     BitVec operator&(const BitVec& r) const { return BitVec(*this) &= r; }
     BitVec operator|(const BitVec& r) const { return BitVec(*this) |= r; }
     BitVec operator^(const BitVec& r) const { return BitVec(*this) ^= r; }
@@ -168,6 +216,108 @@ struct BitVec {
     }
 };
 
+// BitVec with rank / select index, n < 2^32
+// extra memory is about 8% of the bits
+struct SuccinctBitVec {
+  public:
+    SuccinctBitVec() : SuccinctBitVec(BitVec()) {}
+    explicit SuccinctBitVec(BitVec _bv) : bv(std::move(_bv)) {
+        assert(bv.size() < (1ULL << 32));
+        const auto& d = bv.raw_data();
+        size_t nb = (d.size() + W - 1) / W;
+        cum.resize(nb + 1);
+        for (size_t b = 0; b < nb; b++) {
+            u32 c = 0;
+            for (size_t i = b * W; i < std::min(d.size(), (b + 1) * W); i++) {
+                c += std::popcount(d[i]);
+            }
+            cum[b + 1] = cum[b] + c;
+        }
+        for (size_t b = 0; b < nb; b++) {
+            u32 ones = cum[b + 1], zeros = u32((b + 1) * BLOCK) - cum[b + 1];
+            while (sel1.size() * SAMPLE < ones) sel1.push_back(u32(b));
+            while (sel0.size() * SAMPLE < zeros) sel0.push_back(u32(b));
+        }
+    }
+
+    size_t size() const { return bv.size(); }
+    bool test(size_t i) const { return bv.test(i); }
+    const BitVec& bits() const { return bv; }
+
+    // #{j < i | a[j] = 1}
+    size_t rank1(size_t i) const {
+        assert(i <= size());
+        const auto& d = bv.raw_data();
+        size_t w = i / B;
+        size_t res = cum[w / W];
+        for (size_t j = w / W * W; j < w; j++) res += std::popcount(d[j]);
+        if (i % B) res += std::popcount(d[w] & ~(-1ULL << (i % B)));
+        return res;
+    }
+    // #{j < i | a[j] = 0}
+    size_t rank0(size_t i) const { return i - rank1(i); }
+
+    // position of the k-th (0-indexed) 1, or size() if it does not exist
+    size_t select1(size_t k) const {
+        if (k >= cum.back()) return size();
+        return select<true>(k);
+    }
+    // position of the k-th (0-indexed) 0, or size() if it does not exist
+    size_t select0(size_t k) const {
+        if (k >= size() - cum.back()) return size();
+        return select<false>(k);
+    }
+
+  private:
+    static constexpr size_t B = 64;
+    static constexpr size_t W = 8;  // words per block
+    static constexpr size_t BLOCK = B * W;
+    static constexpr size_t SAMPLE = 4096;
+
+    BitVec bv;
+    // cum[b]: #1 in the first b blocks
+    std::vector<u32> cum = {0};
+    // sel1[j]: block containing the (j * SAMPLE)-th 1
+    std::vector<u32> sel0, sel1;
+
+    template <bool ONE> size_t count_before(size_t b) const {
+        return ONE ? cum[b] : b * BLOCK - cum[b];
+    }
+
+    template <bool ONE> size_t select(size_t k) const {
+        const auto& sel = ONE ? sel1 : sel0;
+        size_t lo = sel[k / SAMPLE];
+        size_t hi = k / SAMPLE + 1 < sel.size() ? sel[k / SAMPLE + 1] + 1
+                                                : cum.size() - 1;
+        // last block b in [lo, hi) with count_before(b) <= k
+        while (hi - lo > 1) {
+            size_t mid = (lo + hi) / 2;
+            (count_before<ONE>(mid) <= k ? lo : hi) = mid;
+        }
+        k -= count_before<ONE>(lo);
+        const auto& d = bv.raw_data();
+        for (size_t w = lo * W;; w++) {
+            u64 x = ONE ? d[w] : ~d[w];
+            size_t c = std::popcount(x);
+            if (k < c) return w * B + select_in_word(x, int(k));
+            k -= c;
+        }
+    }
+
+    static size_t select_in_word(u64 x, int k) {
+        size_t pos = 0;
+        for (int w = 32; w; w >>= 1) {
+            int c = std::popcount(x & ((1ULL << w) - 1));
+            if (k >= c) {
+                k -= c;
+                x >>= w;
+                pos += w;
+            }
+        }
+        return pos;
+    }
+};
+
 namespace internal {
 
 // bitvec
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "yosupo/container/hashmap.hpp"
+#include "yosupo/hash.hpp"
+#include "yosupo/types.hpp"
+
+namespace yosupo {
+
+// thread-safe hash map, sharded IncrementalHashMap with reader-writer locks
+template <class K, class D, class H = Hasher> struct ConcurrentHashMap {
+  public:
+    // 2^shard_log shards
+    explicit ConcurrentHashMap(int _shard_log = 6, const H& _h = H())
+        : h(_h), shard_log(_shard_log) {
+        assert(1 <= shard_log && shard_log <= 16);
+        for (int i = 0; i < (1 << shard_log); i++) {
+            shards.push_back(std::make_unique<Shard>(_h));
+        }
+    }
+
+    // mp[k] = d
+    void insert_or_assign(const K& k, const D& d) {
+        auto& s = shard(k);
+        std::unique_lock lock(s.mtx);
+        s.mp[k] = d;
+    }
+
+    // mp[k] = contains(k) ? f(mp[k], d) : d
+    template <class F> void upsert(const K& k, const D& d, F f) {
+        auto& s = shard(k);
+        std::unique_lock lock(s.mtx);
+        auto it = s.mp.find(k);
+        if (it == s.mp.end()) {
+            s.mp[k] = d;
+        } else {
+            it->second = f(std::as_const(it->second), d);
+        }
+    }
+
+    std::optional<D> get(const K& k) const {
+        const auto& s = shard(k);
+        std::shared_lock lock(s.mtx);
+        auto it = s.mp.find(k);
+        if (it == s.mp.end()) return std::nullopt;
+        return it->second;
+    }
+
+    bool contains(const K& k) const {
+        const auto& s = shard(k);
+        std::shared_lock lock(s.mtx);
+        return s.mp.contains(k);
+    }
+
+    // @return the number of erased elements (0 or 1)
+    size_t erase(const K& k) {
+        auto& s = shard(k);
+        std::unique_lock lock(s.mtx);
+        return s.mp.erase(k);
+    }
+
+    size_t size() const {
+        size_t sum = 0;
+        for (const auto& s : shards) {
+            std::shared_lock lock(s->mtx);
+            sum += s->mp.size();
+        }
+        return sum;
+    }
+
+    // call f(key, value) for all elements, shards are split among threads
+    // f must be thread-safe if threads > 1
+    template <class F> void for_each(F f, int threads = 1) const {
+        assert(threads >= 1);
+        auto run = [&](int t) {
+            for (size_t i = t; i < shards.size(); i += threads) {
+                std::shared_lock lock(shards[i]->mtx);
+                for (const auto& [key, val] : shards[i]->mp) f(key, val);
+            }
+        };
+        std::vector<std::thread> workers;
+        for (int t = 1; t < threads; t++) workers.emplace_back(run, t);
+        run(0);
+        for (auto& w : workers) w.join();
+    }
+
+  private:
+    struct alignas(64) Shard {
+        explicit Shard(const H& _h) : mp(_h) {}
+        mutable std::shared_mutex mtx;
+        IncrementalHashMap<K, D, H> mp;
+    };
+
+    H h;
+    int shard_log;
+    std::vector<std::unique_ptr<Shard>> shards;
+
+    // IncrementalHashMap uses the lower bits, use the upper bits here
+    Shard& shard(const K& k) { return *shards[h(k) >> (64 - shard_log)]; }
+    const Shard& shard(const K& k) const {
+        return *shards[h(k) >> (64 - shard_log)];
+    }
+};
+
+}  // namespace yosupo
@@ -54,6 +54,11 @@ template <acted_monoid M> struct DynamicSegtree {
 
     Tree build(int len) { return Tree(len, manager.build()); }
 
+    // set all elements of tr to e and free its nodes
+    void clear(Tree& tr) { manager.clear(tr.tr); }
+    // free all nodes, every Tree built so far becomes invalid
+    void reset() { manager.reset(); }
+
     typename M::S get(Tree& tr, int k) {
         assert(0 <= k && k < tr.len);
         int i = lower_bound_idx(tr, k);
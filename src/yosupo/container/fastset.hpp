@@ -6,6 +6,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <iterator>
+#include <span>
 #include <utility>
 #include <vector>
 
@@ -68,6 +69,52 @@ struct FastSet {
         }
     }
 
+    // a[l], a[l + 1], ..., a[r - 1] = true
+    void set_range(int l, int r) {
+        assert(0 <= l && l <= r && r <= _n);
+        for (int h = 0; h < _log && l < r; h++) {
+            set_bits(seg[h], l, r);
+            l /= B;
+            r = (r - 1) / B + 1;
+        }
+    }
+
+    // a[l], a[l + 1], ..., a[r - 1] = false
+    void reset_range(int l, int r) {
+        assert(0 <= l && l <= r && r <= _n);
+        for (int h = 0; h < _log && l < r; h++) {
+            reset_bits(seg[h], l, r);
+            // words strictly inside [l, r) are now empty
+            int lw = l / B, rw = (r - 1) / B;
+            l = lw + (seg[h][lw] != 0);
+            r = rw + (seg[h][rw] == 0);
+        }
+    }
+
+    // out[j] = a[idx[j]]
+    void get(std::span<const int> idx, std::span<bool> out) const {
+        assert(idx.size() == out.size());
+        for (size_t j = 0; j < idx.size(); j++) {
+            out[j] = (seg[0][idx[j] / B] >> (idx[j] % B) & 1) != 0;
+        }
+    }
+
+    // @return i以上の要素を小さい順に最大k個
+    std::vector<int> next_k(int i, int k) const {
+        std::vector<int> res;
+        i = or_more(i);
+        while (i < _n && int(res.size()) < k) {
+            int w = i / B;
+            uint64_t d = seg[0][w] & (~0ULL << (i % B));
+            while (d && int(res.size()) < k) {
+                res.push_back(w * B + std::countr_zero(d));
+                d &= d - 1;
+            }
+            i = or_more((w + 1) * B);
+        }
+        return res;
+    }
+
     // @return i以上最小の要素 or n
     int or_more(int i) const {
         if (i >= _n) return _n;
@@ -179,6 +226,34 @@ struct FastSet {
   private:
     int _n, _log;
     std::vector<std::vector<uint64_t>> seg;
+
+    // set bits [l, r) of v, l < r
+    static void set_bits(std::vector<uint64_t>& v, int l, int r) {
+        int lw = l / B, rw = (r - 1) / B;
+        uint64_t lm = ~0ULL << (l % B);
+        uint64_t rm = ~0ULL >> (B - 1 - (r - 1) % B);
+        if (lw == rw) {
+            v[lw] |= lm & rm;
+            return;
+        }
+        v[lw] |= lm;
+        std::fill(v.begin() + lw + 1, v.begin() + rw, ~0ULL);
+        v[rw] |= rm;
+    }
+
+    // reset bits [l, r) of v, l < r
+    static void reset_bits(std::vector<uint64_t>& v, int l, int r) {
+        int lw = l / B, rw = (r - 1) / B;
+        uint64_t lm = ~0ULL << (l % B);
+        uint64_t rm = ~0ULL >> (B - 1 - (r - 1) % B);
+        if (lw == rw) {
+            v[lw] &= ~(lm & rm);
+            return;
+        }
+        v[lw] &= ~lm;
+        std::fill(v.begin() + lw + 1, v.begin() + rw, 0ULL);
+        v[rw] &= ~rm;
+    }
 };
 
 }  // namespace yosupo
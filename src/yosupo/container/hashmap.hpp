@@ -1,11 +1,13 @@
 #pragma once
 
+#include <algorithm>
 #include <cstddef>
 #include <iterator>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "yosupo/container/internal_hashtable.hpp"
 #include "yosupo/dump.hpp"
 #include "yosupo/hash.hpp"
 #include "yosupo/types.hpp"
@@ -29,8 +31,8 @@ template <class K, class D, class H = Hasher> struct IncrementalHashMap {
         u32 _pos;
         Iterator(IncrementalHashMap& mp, u32 pos) : _mp(mp), _pos(pos) {}
 
-        std::pair<K, D>& operator*() const { return _mp.data[_pos]; }
-        std::pair<K, D>* operator->() const { return &_mp.data[_pos]; }
+        std::pair<K, D>& operator*() const { return _mp.slot(_pos); }
+        std::pair<K, D>* operator->() const { return &_mp.slot(_pos); }
 
         Iterator& operator++() {
             _pos = _mp.next_bucket(_pos + 1);
@@ -59,8 +61,8 @@ template <class K, class D, class H = Hasher> struct IncrementalHashMap {
         ConstIterator(const IncrementalHashMap& mp, u32 pos)
             : _mp(mp), _pos(pos) {}
 
-        const std::pair<K, D>& operator*() const { return _mp.data[_pos]; }
-        const std::pair<K, D>* operator->() const { return &_mp.data[_pos]; }
+        const std::pair<K, D>& operator*() const { return _mp.slot(_pos); }
+        const std::pair<K, D>* operator->() const { return &_mp.slot(_pos); }
 
         ConstIterator& operator++() {
             _pos = _mp.next_bucket(_pos + 1);
@@ -82,62 +84,63 @@ template <class K, class D, class H = Hasher> struct IncrementalHashMap {
 
   public:
     IncrementalHashMap(size_t s, const H& _h = H())
-        : h(_h),
-          mask((1 << s) - 1),
-          filled(0),
-          used(mask + 1),
-          data(mask + 1) {}
+        : h(_h), cur(std::max(u32(1) << s, u32(Group::SIZE))) {}
     IncrementalHashMap(const H& _h = H()) : IncrementalHashMap(2, _h) {}
 
     Iterator begin() { return Iterator(*this, next_bucket(0)); }
-    Iterator end() { return Iterator(*this, mask + 1); }
+    Iterator end() { return Iterator(*this, slot_count()); }
     ConstIterator begin() const { return ConstIterator(*this, next_bucket(0)); }
-    ConstIterator end() const { return ConstIterator(*this, mask + 1); }
+    ConstIterator end() const { return ConstIterator(*this, slot_count()); }
     ConstIterator cbegin() const { return begin(); }
     ConstIterator cend() const { return end(); }
 
     using iterator = Iterator;
     using const_iterator = ConstIterator;
 
+    // lookups and erase never move elements, so references are valid until
+    // the next insertion (which may move elements, like a rehash)
     D& operator[](const K& k) {
-        u32 i = start_bucket(k);
-        while (used[i] && data[i].first != k) {
-            i = (i + 1) & mask;
-        }
-        if (!used[i]) {
-            if (filled * 2 > mask) {
-                rehash();
-                return (*this)[k];
+        u64 hs = h(k);
+        if (u32 i = cur.find(k, hs); i < cur.cap()) return cur.data[i].second;
+        if (migrating()) {
+            if (u32 i = old.find(k, hs); i < old.cap()) {
+                return old.data[i].second;
             }
-            filled++;
-            used[i] = true;
-            data[i] = {k, D()};
         }
-        return data[i].second;
+        migrate(MIGRATE_STEP);
+        if (cur.need_rehash()) start_rehash(cur.cap());
+        u32 i = cur.insert(hs);
+        cur.data[i] = {k, D()};
+        return cur.data[i].second;
     }
 
-    Iterator find(const K& k) {
-        u32 i = start_bucket(k);
-        while (used[i] && data[i].first != k) {
-            i = (i + 1) & mask;
-        }
-        if (!used[i]) return end();
-        return Iterator(*this, i);
-    }
+    Iterator find(const K& k) { return Iterator(*this, find_slot(k)); }
 
     ConstIterator find(const K& k) const {
-        u32 i = start_bucket(k);
-        while (used[i] && data[i].first != k) {
-            i = (i + 1) & mask;
-        }
-        if (!used[i]) return cend();
-        return ConstIterator(*this, i);
+        return ConstIterator(*this, find_slot(k));
     }
 
     size_t count(const K& k) const { return this->find(k) != cend() ? 1 : 0; }
     bool contains(const K& k) const { return this->find(k) != cend(); }
 
-    size_t size() const { return filled; }
+    // @return the number of erased elements (0 or 1)
+    size_t erase(const K& k) {
+        u64 hs = h(k);
+        if (cur.erase(k, hs)) return 1;
+        if (migrating() && old.erase(k, hs)) return 1;
+        return 0;
+    }
+
+    // allocate buckets for n elements, so that no rehash happens until then
+    void reserve(size_t n) {
+        u32 cap = cur.cap();
+        while ((n + 1) * 8 > size_t(cap) * 7) cap *= 2;
+        if (cap == cur.cap()) return;
+        start_rehash(cap);
+        migrate(old.cap());
+    }
+
+    size_t size() const { return cur.filled + old.filled; }
 
     std::string dump() const {
         std::string s = "{";
@@ -156,30 +159,128 @@ template <class K, class D, class H = Hasher> struct IncrementalHashMap {
     }
 
   private:
-    Hasher h;
-
-    u32 mask, filled;  // data.size() == 1 << s
-
-    std::vector<bool> used;
-    std::vector<Data> data;
-
-    void rehash() {
-        u32 pmask = mask;
-        mask = mask * 2 + 1;
-        filled = 0;
-        auto pused = std::exchange(used, std::vector<bool>(mask + 1));
-        auto pdata = std::exchange(data, std::vector<Data>(mask + 1));
-        for (u32 i = 0; i <= pmask; i++) {
-            if (pused[i]) {
-                (*this)[pdata[i].first] = pdata[i].second;
+    using Group = internal::CtrlGroup;
+
+    // number of old buckets moved per insertion
+    // cur keeps >= cap(cur) / 8 free buckets after a rehash and
+    // cap(cur) >= cap(old), so the migration finishes before the next rehash
+    static constexpr u32 MIGRATE_STEP = 8;
+
+    struct Table {
+        u32 mask = 0, filled = 0, deleted = 0;  // cap() == mask + 1
+        std::vector<u8> ctrl;
+        std::vector<Data> data;
+
+        Table() = default;
+        explicit Table(u32 cap)
+            : mask(cap - 1), ctrl(cap, internal::CTRL_EMPTY), data(cap) {}
+
+        u32 cap() const { return u32(data.size()); }
+        bool need_rehash() const {
+            return (filled + deleted + 1) * 8 > cap() * 7;
+        }
+
+        // @return the bucket of k, or cap()
+        u32 find(const K& k, u64 hs) const {
+            u8 h2 = u8(hs & 0x7f);
+            u32 g = u32(hs >> 7) & (mask / Group::SIZE);
+            for (u32 step = 1;; step++) {
+                Group grp(ctrl.data() + g * Group::SIZE);
+                for (u64 m = grp.match(h2); m; m &= m - 1) {
+                    u32 i = g * Group::SIZE + Group::lowest(m);
+                    if (ctrl[i] == h2 && data[i].first == k) return i;
+                }
+                if (grp.match_empty()) return cap();
+                g = (g + step) & (mask / Group::SIZE);
             }
         }
+
+        // mark a free bucket on the probe sequence of hs as full and return
+        u32 insert(u64 hs) {
+            u32 g = u32(hs >> 7) & (mask / Group::SIZE);
+            for (u32 step = 1;; step++) {
+                Group grp(ctrl.data() + g * Group::SIZE);
+                if (u64 m = grp.match_empty_or_deleted()) {
+                    u32 i = g * Group::SIZE + Group::lowest(m);
+                    if (ctrl[i] == internal::CTRL_DELETED) deleted--;
+                    ctrl[i] = u8(hs & 0x7f);
+                    filled++;
+                    return i;
+                }
+                g = (g + step) & (mask / Group::SIZE);
+            }
+        }
+
+        void erase_bucket(u32 i) {
+            ctrl[i] = internal::CTRL_DELETED;
+            filled--;
+            deleted++;
+        }
+
+        bool erase(const K& k, u64 hs) {
+            u32 i = find(k, hs);
+            if (i == cap()) return false;
+            erase_bucket(i);
+            data[i] = Data();
+            return true;
+        }
+    };
+
+    H h;
+
+    // while migrating, old.data[0..migrated) have been moved to cur
+    Table cur, old;
+    u32 migrated = 0;
+
+    bool migrating() const { return old.cap() != 0; }
+
+    void start_rehash(u32 cap) {
+        migrate(old.cap());
+        // only drop tombstones if the live elements are few
+        if ((cur.filled + 1) * 16 > cur.cap() * 7) {
+            cap = std::max(cap, cur.cap() * 2);
+        }
+        old = std::exchange(cur, Table(cap));
+        migrated = 0;
     }
 
-    u32 start_bucket(const K& k) const { return (u32)(h(k)) & mask; }
+    // move up to step buckets of old to cur
+    void migrate(u32 step) {
+        if (!migrating()) return;
+        u32 r = std::min(old.cap(), migrated + step);
+        for (; migrated < r; migrated++) {
+            if (!internal::ctrl_is_full(old.ctrl[migrated])) continue;
+            auto& x = old.data[migrated];
+            cur.data[cur.insert(h(x.first))] = std::move(x);
+            old.erase_bucket(migrated);
+        }
+        if (migrated == old.cap()) old = Table();
+    }
+
+    // slot i: cur.data[i] or old.data[i - cur.cap()]
+    u32 slot_count() const { return cur.cap() + old.cap(); }
+    Data& slot(u32 i) {
+        return i < cur.cap() ? cur.data[i] : old.data[i - cur.cap()];
+    }
+    const Data& slot(u32 i) const {
+        return i < cur.cap() ? cur.data[i] : old.data[i - cur.cap()];
+    }
+    bool slot_is_full(u32 i) const {
+        return internal::ctrl_is_full(i < cur.cap() ? cur.ctrl[i]
+                                                    : old.ctrl[i - cur.cap()]);
+    }
+
+    u32 find_slot(const K& k) const {
+        u64 hs = h(k);
+        if (u32 i = cur.find(k, hs); i < cur.cap()) return i;
+        if (migrating()) {
+            if (u32 i = old.find(k, hs); i < old.cap()) return cur.cap() + i;
+        }
+        return slot_count();
+    }
 
     u32 next_bucket(u32 i) const {
-        while (i <= mask && !used[i]) i++;
+        while (i < slot_count() && !slot_is_full(i)) i++;
         return i;
     }
 };
@@ -1,11 +1,13 @@
 #pragma once
 
+#include <algorithm>
 #include <cstddef>
 #include <iterator>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "yosupo/container/internal_hashtable.hpp"
 #include "yosupo/dump.hpp"
 #include "yosupo/hash.hpp"
 #include "yosupo/types.hpp"
@@ -78,9 +80,10 @@ template <class K, class H = Hasher> struct IncrementalHashSet {
   public:
     IncrementalHashSet(size_t s, const H& _h = H())
         : h(_h),
-          mask((1 << s) - 1),
+          mask(std::max(u32(1) << s, u32(Group::SIZE)) - 1),
           filled(0),
-          used(mask + 1),
+          deleted(0),
+          ctrl(mask + 1, internal::CTRL_EMPTY),
           keys(mask + 1) {}
     IncrementalHashSet(const H& _h = H()) : IncrementalHashSet(2, _h) {}
 
@@ -95,41 +98,31 @@ template <class K, class H = Hasher> struct IncrementalHashSet {
     using const_iterator = ConstIterator;
 
     void insert(const K& k) {
-        u32 i = start_bucket(k);
-        while (used[i] && keys[i] != k) {
-            i = (i + 1) & mask;
-        }
-        if (!used[i]) {
-            if (filled * 2 > mask) {
-                rehash();
-                return this->insert(k);
-            }
-            filled++;
-            used[i] = true;
-            keys[i] = k;
-        }
+        u64 hs = h(k);
+        if (find_bucket(k, hs) <= mask) return;
+        if ((filled + deleted + 1) * 8 > (mask + 1) * 7) rehash();
+        keys[insert_bucket(hs)] = k;
     }
 
-    Iterator find(const K& k) {
-        u32 i = start_bucket(k);
-        while (used[i] && keys[i] != k) {
-            i = (i + 1) & mask;
-        }
-        if (!used[i]) return end();
-        return Iterator(*this, i);
-    }
+    Iterator find(const K& k) { return Iterator(*this, find_bucket(k, h(k))); }
 
     ConstIterator find(const K& k) const {
-        u32 i = start_bucket(k);
-        while (used[i] && keys[i] != k) {
-            i = (i + 1) & mask;
-        }
-        if (!used[i]) return end();
-        return ConstIterator(*this, i);
+        return ConstIterator(*this, find_bucket(k, h(k)));
     }
 
     bool contains(const K& k) const { return this->find(k) != end(); }
 
+    // @return the number of erased elements (0 or 1)
+    size_t erase(const K& k) {
+        u32 i = find_bucket(k, h(k));
+        if (i > mask) return 0;
+        ctrl[i] = internal::CTRL_DELETED;
+        keys[i] = K();
+        filled--;
+        deleted++;
+        return 1;
+    }
+
     int size() const { return filled; }
 
     std::string dump() const {
@@ -147,30 +140,64 @@ template <class K, class H = Hasher> struct IncrementalHashSet {
     }
 
   private:
-    Hasher h;
+    using Group = internal::CtrlGroup;
 
-    u32 mask, filled;  // data.size() == 1 << s
+    H h;
 
-    std::vector<bool> used;
+    u32 mask, filled, deleted;  // keys.size() == mask + 1
+
+    std::vector<u8> ctrl;
     std::vector<K> keys;
 
     void rehash() {
         u32 pmask = mask;
-        mask = mask * 2 + 1;
+        // only drop tombstones if the live elements are few
+        if ((filled + 1) * 16 > (mask + 1) * 7) mask = mask * 2 + 1;
         filled = 0;
-        auto pused = std::exchange(used, std::vector<bool>(mask + 1));
+        deleted = 0;
+        auto pctrl = std::exchange(
+            ctrl, std::vector<u8>(mask + 1, internal::CTRL_EMPTY));
         auto pkeys = std::exchange(keys, std::vector<K>(mask + 1));
         for (u32 i = 0; i <= pmask; i++) {
-            if (pused[i]) {
-                this->insert(pkeys[i]);
+            if (internal::ctrl_is_full(pctrl[i])) {
+                keys[insert_bucket(h(pkeys[i]))] = std::move(pkeys[i]);
+            }
+        }
+    }
+
+    // @return the bucket of k, or mask + 1
+    u32 find_bucket(const K& k, u64 hs) const {
+        u8 h2 = u8(hs & 0x7f);
+        u32 g = u32(hs >> 7) & (mask / Group::SIZE);
+        for (u32 step = 1;; step++) {
+            Group grp(ctrl.data() + g * Group::SIZE);
+            for (u64 m = grp.match(h2); m; m &= m - 1) {
+                u32 i = g * Group::SIZE + Group::lowest(m);
+                if (ctrl[i] == h2 && keys[i] == k) return i;
             }
+            if (grp.match_empty()) return mask + 1;
+            g = (g + step) & (mask / Group::SIZE);
         }
     }
 
-    u32 start_bucket(const K& k) const { return (u32)(h(k)) & mask; }
+    // mark a free bucket on the probe sequence of hs as full and return it
+    u32 insert_bucket(u64 hs) {
+        u32 g = u32(hs >> 7) & (mask / Group::SIZE);
+        for (u32 step = 1;; step++) {
+            Group grp(ctrl.data() + g * Group::SIZE);
+            if (u64 m = grp.match_empty_or_deleted()) {
+                u32 i = g * Group::SIZE + Group::lowest(m);
+                if (ctrl[i] == internal::CTRL_DELETED) deleted--;
+                ctrl[i] = u8(hs & 0x7f);
+                filled++;
+                return i;
+            }
+            g = (g + step) & (mask / Group::SIZE);
+        }
+    }
 
     u32 next_bucket(u32 i) const {
-        while (i <= mask && !used[i]) i++;
+        while (i <= mask && !internal::ctrl_is_full(ctrl[i])) i++;
         return i;
     }
 };
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <bit>
+#include <cstring>
+
+#include "yosupo/types.hpp"
+
+namespace yosupo {
+
+namespace internal {
+
+// control bytes of swiss-table style hash tables
+// 0b0xxxxxxx: full, xxxxxxx is the lower 7 bits of the hash
+constexpr u8 CTRL_EMPTY = 0x80;
+constexpr u8 CTRL_DELETED = 0xfe;
+
+inline bool ctrl_is_full(u8 c) { return !(c & 0x80); }
+
+// 8 control bytes, matched at once by SWAR
+struct CtrlGroup {
+    static constexpr int SIZE = 8;
+    static constexpr u64 LSBS = 0x0101010101010101ULL;
+    static constexpr u64 MSBS = 0x8080808080808080ULL;
+
+    explicit CtrlGroup(const u8* p) { std::memcpy(&ctrl, p, SIZE); }
+
+    // may have false positives, caller must check the control byte
+    u64 match(u8 h2) const {
+        u64 x = ctrl ^ (LSBS * h2);
+        return (x - LSBS) & ~x & MSBS;
+    }
+    u64 match_empty() const { return ctrl & ~(ctrl << 6) & MSBS; }
+    u64 match_empty_or_deleted() const { return ctrl & MSBS; }
+
+    // index of the lowest matched slot
+    static int lowest(u64 m) { return std::countr_zero(m) / 8; }
+
+  private:
+    u64 ctrl;
+};
+
+}  // namespace internal
+
+}  // namespace yosupo
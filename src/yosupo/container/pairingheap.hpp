@@ -0,0 +1,139 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace yosupo {
+
+// Pairing heap, nodes are stored in the manager
+// push returns the node id, which is valid until the node is popped
+template <class T, class Comp = std::less<T>> struct PairingHeapManager {
+    Comp comp;
+    PairingHeapManager(const Comp& _comp = Comp()) : comp(_comp) {}
+
+    struct Heap {
+        int root = -1;
+        size_t sz = 0;
+        size_t size() const { return sz; }
+        bool empty() const { return size() == 0; }
+        void clear() { *this = Heap(); }
+    };
+
+    Heap build() { return Heap(); }
+
+    Heap build(const std::vector<T>& d) {
+        Heap h;
+        for (const auto& x : d) push(h, x);
+        return h;
+    }
+
+    int push(Heap& h, const T& x) {
+        int id;
+        if (free_ids.empty()) {
+            id = int(nodes.size());
+            nodes.push_back(Node{x, -1, -1, -1});
+        } else {
+            id = free_ids.back();
+            free_ids.pop_back();
+            nodes[id] = Node{x, -1, -1, -1};
+        }
+        h.root = link(h.root, id);
+        h.sz++;
+        return id;
+    }
+
+    void pop(Heap& h) {
+        assert(!h.empty());
+        int r = h.root;
+        h.root = merge_children(r);
+        h.sz--;
+        free_ids.push_back(r);
+    }
+
+    void pop_push(Heap& h, const T& x) {
+        pop(h);
+        push(h, x);
+    }
+
+    const T& top(const Heap& h) const { return nodes[h.root].key; }
+
+    const T& get(int id) const { return nodes[id].key; }
+
+    // x must not be worse than the current key, i.e. !comp(x, get(id))
+    void decrease_key(Heap& h, int id, const T& x) {
+        assert(!comp(x, nodes[id].key));
+        nodes[id].key = x;
+        if (id == h.root) return;
+        cut(id);
+        h.root = link(h.root, id);
+    }
+
+    void meld(Heap& h, Heap& other) {
+        h.root = link(h.root, other.root);
+        h.sz += other.sz;
+        other = build();
+    }
+
+    size_t size(const Heap& h) const { return h.size(); }
+
+  private:
+    struct Node {
+        T key;
+        // prev: parent if this is the first child, otherwise left sibling
+        int child, sibling, prev;
+    };
+    std::vector<Node> nodes;
+    std::vector<int> free_ids;
+    std::vector<int> buf;
+
+    // a, b: roots
+    int link(int a, int b) {
+        if (a == -1) return b;
+        if (b == -1) return a;
+        if (comp(nodes[a].key, nodes[b].key)) std::swap(a, b);
+        int c = nodes[a].child;
+        nodes[b].sibling = c;
+        if (c != -1) nodes[c].prev = b;
+        nodes[b].prev = a;
+        nodes[a].child = b;
+        return a;
+    }
+
+    void cut(int id) {
+        int p = nodes[id].prev, s = nodes[id].sibling;
+        if (nodes[p].child == id) {
+            nodes[p].child = s;
+        } else {
+            nodes[p].sibling = s;
+        }
+        if (s != -1) nodes[s].prev = p;
+        nodes[id].sibling = nodes[id].prev = -1;
+    }
+
+    // two-pass pairing
+    int merge_children(int id) {
+        buf.clear();
+        for (int c = nodes[id].child; c != -1;) {
+            int d = nodes[c].sibling;
+            nodes[c].sibling = nodes[c].prev = -1;
+            if (d == -1) {
+                buf.push_back(c);
+                break;
+            }
+            int e = nodes[d].sibling;
+            nodes[d].sibling = nodes[d].prev = -1;
+            buf.push_back(link(c, d));
+            c = e;
+        }
+        int r = -1;
+        for (auto i = std::ssize(buf) - 1; i >= 0; i--) {
+            r = link(buf[i], r);
+        }
+        return r;
+    }
+};
+
+}  // namespace yosupo
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace yosupo {
+
+// min-heap for monotone keys: pushed keys must be >= the last popped key
+// same interface as MeldableBinaryHeapManager, but top() is the minimum
+// (MeldableDaryHeapManager with std::less is a max-heap)
+template <std::unsigned_integral Key, class Value> struct RadixHeapManager {
+    using T = std::pair<Key, Value>;
+    static constexpr int BITS = std::numeric_limits<Key>::digits;
+
+    struct Heap {
+        // bucket[i]: keys with bit_width(key ^ last) == i
+        std::array<std::vector<T>, BITS + 1> bucket;
+        Key last = 0;
+        size_t sz = 0;
+        size_t size() const { return sz; }
+        bool empty() const { return size() == 0; }
+        void clear() {
+            for (auto& b : bucket) b.clear();
+            last = 0;
+            sz = 0;
+        }
+    };
+
+    Heap build() { return Heap(); }
+
+    Heap build(std::vector<T> d) {
+        auto h = build();
+        for (const auto& x : d) push(h, x);
+        return h;
+    }
+
+    void push(Heap& h, const T& x) {
+        assert(h.last <= x.first);
+        h.bucket[std::bit_width(Key(x.first ^ h.last))].push_back(x);
+        h.sz++;
+    }
+
+    void pop(Heap& h) {
+        normalize(h);
+        h.bucket[0].pop_back();
+        h.sz--;
+    }
+
+    // x.first must be >= top(h).first
+    void pop_push(Heap& h, const T& x) {
+        pop(h);
+        push(h, x);
+    }
+
+    const T& top(Heap& h) {
+        normalize(h);
+        return h.bucket[0].back();
+    }
+
+    // all keys of h and other must be >= the last popped keys of both
+    void meld(Heap& h, Heap& other) {
+        if (h.size() < other.size()) std::swap(h, other);
+        for (auto& b : other.bucket) {
+            for (const auto& x : b) push(h, x);
+        }
+        other = build();
+    }
+
+    size_t size(const Heap& h) const { return h.size(); }
+
+  private:
+    // move the minimum keys to bucket[0]
+    void normalize(Heap& h) {
+        assert(!h.empty());
+        if (!h.bucket[0].empty()) return;
+        int i = 1;
+        while (h.bucket[i].empty()) i++;
+        auto b = std::move(h.bucket[i]);
+        h.bucket[i].clear();
+        h.last = std::ranges::min_element(b, {}, &T::first)->first;
+        for (const auto& x : b) {
+            h.bucket[std::bit_width(Key(x.first ^ h.last))].push_back(x);
+        }
+    }
+};
+
+}  // namespace yosupo
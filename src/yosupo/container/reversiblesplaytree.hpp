@@ -6,15 +6,21 @@
 #include <utility>
 #include <vector>
 
+#include "yosupo/container/arena.hpp"
+
 namespace yosupo {
 
 template <class M> struct SplayTree {
     using S = typename M::S;
     using F = typename M::F;
 
-    SplayTree(const M& _m) : m(_m) {
+    SplayTree(const M& _m) : m(_m) { reset(); }
+
+    // free all nodes, every Tree built so far becomes invalid
+    void reset() {
+        nodes.clear();
         // last node
-        nodes.push_back(Node{
+        nodes.alloc(Node{
             .l = -1,
             .r = -1,
             .len = 0,
@@ -36,8 +42,7 @@ template <class M> struct SplayTree {
     ptrdiff_t ssize(const Tree& t) { return size(t); }
 
     int new_node(const S& s, int l, int r) {
-        int id = int(nodes.size());
-        nodes.push_back(Node{.l = l, .r = r, .s = s, .f = m.act.e});
+        int id = nodes.alloc(Node{.l = l, .r = r, .s = s, .f = m.act.e});
         update(id);
         return id;
     }
@@ -118,6 +123,20 @@ template <class M> struct SplayTree {
         t = merge3(std::move(t1), std::move(t2), std::move(t3));
     }
 
+    // free all nodes of t
+    void clear(Tree& t) {
+        if (t.empty()) return;
+        std::vector<int> st = {t.id};
+        while (!st.empty()) {
+            int id = st.back();
+            st.pop_back();
+            if (nodes[id].l) st.push_back(nodes[id].l);
+            if (nodes[id].r) st.push_back(nodes[id].r);
+            nodes.free(id);
+        }
+        t = Tree();
+    }
+
     void reverse(Tree& t) {
         if (t.empty()) return;
         reverse(t.id);
@@ -132,7 +151,7 @@ template <class M> struct SplayTree {
         F f;
         bool rev;
     };
-    std::vector<Node> nodes;
+    NodeArena<Node> nodes;
 
     void reverse(int id) {
         Node& n = nodes[id];
@@ -56,6 +56,12 @@ template <monoid M> struct SegTree2D {
 
     S all_prod() { return manager.all_prod(d[1]); }
 
+    // set all elements to e, and free the nodes
+    void clear() {
+        manager.reset();
+        d = std::vector(2 * size2, manager.build(size.c()));
+    }
+
   private:
     Coord size;
     M m;
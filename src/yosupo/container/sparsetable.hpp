@@ -1,19 +1,29 @@
+#pragma once
+
 #include <sys/types.h>
 
+#include <algorithm>
 #include <bit>
 #include <cassert>
+#include <concepts>
+#include <thread>
 #include <vector>
 
 #include "yosupo/algebra.hpp"
+#include "yosupo/types.hpp"
 
 namespace yosupo {
 
+// each level is split among threads, op must be thread-safe if threads > 1
 template <monoid M> struct SparseTable {
     using S = M::S;
 
-    M m;
+    // op of some monoids (e.g. ReversibleMonoid) is not const
+    mutable M m;
     std::vector<std::vector<S>> data;
-    SparseTable(std::vector<S> d, const M& _m = M()) : m(_m) {
+    SparseTable(std::vector<S> d, const M& _m = M(), int threads = 1)
+        : m(_m) {
+        assert(threads >= 1);
         int n = int(d.size());
         if (n == 0) return;
         int lg = 32 - std::countl_zero(uint(n));
@@ -21,14 +31,23 @@ template <monoid M> struct SparseTable {
         data[0] = d;
         int l = 1;
         for (int s = 1; s < lg; s++) {
-            data[s] = std::vector<S>(n);
-            for (int i = 0; i < n - l; i++) {
-                data[s][i] = m.op(data[s - 1][i], data[s - 1][i + l]);
-            }
+            data[s] = std::vector<S>(n, m.e);
+            int len = n - l;
+            auto run = [&](int t) {
+                int lw = int(i64(len) * t / threads);
+                int up = int(i64(len) * (t + 1) / threads);
+                for (int i = lw; i < up; i++) {
+                    data[s][i] = m.op(data[s - 1][i], data[s - 1][i + l]);
+                }
+            };
+            std::vector<std::thread> workers;
+            for (int t = 1; t < threads; t++) workers.emplace_back(run, t);
+            run(0);
+            for (auto& w : workers) w.join();
             l <<= 1;
         }
     }
-    M::S query(int l, int r) {
+    M::S query(int l, int r) const {
         assert(l <= r);
         if (l == r) return m.e;
         int u = 31 - std::countl_zero(uint(r - l));
@@ -36,4 +55,72 @@ template <monoid M> struct SparseTable {
     }
 };
 
+// O(n) memory, O(1) query
+// op must be selective, i.e. op(a, b) is always a or b (e.g. min, max)
+// blocks are split among threads, op must be thread-safe if threads > 1
+template <monoid M>
+    requires std::equality_comparable<typename M::S>
+struct LinearSparseTable {
+    using S = M::S;
+    static constexpr int B = 64;
+
+    LinearSparseTable(std::vector<S> d, const M& _m = M(), int threads = 1)
+        : m(_m), n(int(d.size())), data(std::move(d)), mask(n) {
+        assert(threads >= 1);
+        int nb = (n + B - 1) / B;
+        std::vector<S> block(nb, m.e);
+        auto run = [&](int t) {
+            for (int b = int(i64(nb) * t / threads);
+                 b < int(i64(nb) * (t + 1) / threads); b++) {
+                build_block(b, block);
+            }
+        };
+        std::vector<std::thread> workers;
+        for (int t = 1; t < threads; t++) workers.emplace_back(run, t);
+        run(0);
+        for (auto& w : workers) w.join();
+        table = SparseTable<M>(std::move(block), m, threads);
+    }
+
+    S query(int l, int r) const {
+        assert(0 <= l && l <= r && r <= n);
+        if (l == r) return m.e;
+        r--;
+        int bl = l / B, br = r / B;
+        if (bl == br) return in_block(l, r);
+        S sm = in_block(l, bl * B + B - 1);
+        if (bl + 1 < br) sm = m.op(sm, table.query(bl + 1, br));
+        return m.op(sm, in_block(br * B, r));
+    }
+
+  private:
+    mutable M m;
+    int n;
+    std::vector<S> data;
+    std::vector<u64> mask;
+    SparseTable<M> table = SparseTable<M>({}, m);
+
+    // mask of [b * B, (b + 1) * B) and block[b]
+    void build_block(int b, std::vector<S>& block) {
+        int l = b * B, r = std::min(n, l + B);
+        // bit j of st: data[l + j] wins against all of data[l + j + 1..i]
+        u64 st = 0;
+        for (int i = l; i < r; i++) {
+            while (st) {
+                int t = 63 - std::countl_zero(st);
+                if (!(m.op(data[l + t], data[i]) == data[i])) break;
+                st ^= 1ULL << t;
+            }
+            st |= 1ULL << (i - l);
+            mask[i] = st;
+        }
+        block[b] = data[l + std::countr_zero(st)];
+    }
+
+    // [l, r], same block
+    S in_block(int l, int r) const {
+        return data[l + std::countr_zero(mask[r] >> (l % B))];
+    }
+};
+
 }  // namespace yosupo
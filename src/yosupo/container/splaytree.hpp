@@ -1,12 +1,19 @@
+#pragma once
+
 #include <sys/types.h>
 
 #include <array>
+#include <bit>
 #include <cassert>
 #include <cstddef>
+#include <span>
+#include <tuple>
 #include <utility>
 #include <vector>
 
 #include "yosupo/algebra.hpp"
+#include "yosupo/container/arena.hpp"
+#include "yosupo/types.hpp"
 
 namespace yosupo {
 
@@ -14,9 +21,13 @@ template <acted_monoid M> struct SplayTree {
     using S = typename M::S;
     using F = typename M::F;
 
-    SplayTree(const M& _m) : m(_m) {
+    SplayTree(const M& _m) : m(_m) { reset(); }
+
+    // free all nodes, every Tree built so far becomes invalid
+    void reset() {
+        nodes.clear();
         // last node
-        nodes.push_back(Node{
+        nodes.alloc(Node{
             .l = -1,
             .r = -1,
             .len = 0,
@@ -38,21 +49,7 @@ template <acted_monoid M> struct SplayTree {
 
     Tree build() { return Tree(); }
     Tree build(const S& s) { return build(std::vector<S>{s}); }
-    Tree build(const std::vector<S>& v) {
-        auto f = [&](auto self, int lidx, int ridx) -> int {
-            if (lidx == ridx) return 0;
-            assert(lidx <= ridx);
-            if (ridx - lidx == 1) {
-                int id = new_node(v[lidx], 0, 0);
-                return id;
-            }
-            int mid = (lidx + ridx) / 2;
-            int id = new_node(v[mid], self(self, lidx, mid),
-                              self(self, mid + 1, ridx));
-            return id;
-        };
-        return Tree(f(f, 0, int(v.size())));
-    }
+    Tree build(const std::vector<S>& v) { return Tree(build(v, {})); }
 
     S get(Tree& t, int k) {
         assert(0 <= k && k < int(size(t)));
@@ -76,9 +73,116 @@ template <acted_monoid M> struct SplayTree {
         assert(0 <= k && k < ssize(t));
         auto t2 = split(t, k);
         auto t3 = split(t2, 1);
+        nodes.free(t2.id);
         t = merge(std::move(t), std::move(t3));
     }
 
+    // insert v[i].second before the v[i].first-th element of the original t
+    // v must be sorted by position
+    // t is split at each position and linked with the new nodes, or flattened
+    // and relinked in O(n + |v|) if |v| is large
+    void insert_batch(Tree& t, std::span<const std::pair<int, S>> v) {
+        std::vector<int> pos;
+        std::vector<S> s;
+        for (const auto& [k, x] : v) {
+            assert(0 <= k && k <= ssize(t));
+            assert(pos.empty() || pos.back() <= k);
+            pos.push_back(k);
+            s.push_back(x);
+        }
+        if (use_rebuild(size(t), v.size())) {
+            auto old = flatten(t.id);
+            std::vector<int> ids;
+            size_t j = 0;
+            for (size_t i = 0; i <= old.size(); i++) {
+                for (; j < v.size() && pos[j] == int(i); j++) {
+                    ids.push_back(new_node(s[j], 0, 0));
+                }
+                if (i < old.size()) ids.push_back(old[i]);
+            }
+            assert(j == v.size());
+            t = Tree(link(ids));
+            return;
+        }
+        auto gaps = split_batch(std::move(t), pos);
+        t = Tree(build(s, gaps));
+    }
+    // erase the elements at the strictly increasing indices ks
+    void erase_batch(Tree& t, std::span<const int> ks) {
+        if (use_rebuild(size(t), ks.size())) {
+            auto old = flatten(t.id);
+            std::vector<int> ids;
+            size_t j = 0;
+            for (int i = 0; i < std::ssize(old); i++) {
+                if (j < ks.size() && ks[j] == i) {
+                    nodes.free(old[i]);
+                    j++;
+                } else {
+                    ids.push_back(old[i]);
+                }
+            }
+            assert(j == ks.size());
+            t = Tree(link(ids));
+            return;
+        }
+        std::vector<int> pos;
+        for (int k : ks) {
+            assert(pos.empty() || pos.back() <= k);
+            pos.push_back(k);
+            pos.push_back(k + 1);
+        }
+        auto v = split_batch(std::move(t), pos);
+        t = Tree();
+        for (int i = 0; i < std::ssize(v); i++) {
+            if (i % 2) {
+                clear(v[i]);
+            } else {
+                t = merge(std::move(t), std::move(v[i]));
+            }
+        }
+    }
+    // apply f to [l, r) for each (l, r, f) in q
+    // ranges must be sorted and disjoint
+    void apply_batch(Tree& t, std::span<const std::tuple<int, int, F>> q) {
+        if (use_rebuild(size(t), q.size())) {
+            auto ids = flatten(t.id);
+            for (const auto& [l, r, f] : q) {
+                assert(0 <= l && l <= r && r <= std::ssize(ids));
+                for (int i = l; i < r; i++) {
+                    nodes[ids[i]].s = m.mapping(f, nodes[ids[i]].s);
+                }
+            }
+            t = Tree(link(ids));
+            return;
+        }
+        std::vector<int> pos;
+        for (const auto& [l, r, f] : q) {
+            assert(l <= r);
+            pos.push_back(l);
+            pos.push_back(r);
+        }
+        auto v = split_batch(std::move(t), pos);
+        t = Tree();
+        for (int i = 0; i < std::ssize(v); i++) {
+            if (i % 2) all_apply(v[i], std::get<2>(q[i / 2]));
+            t = merge(std::move(t), std::move(v[i]));
+        }
+    }
+
+    // free all nodes of t
+    void clear(Tree& t) {
+        if (t.empty()) return;
+        std::vector<int> st = {t.id};
+        while (!st.empty()) {
+            int id = st.back();
+            st.pop_back();
+            if (nodes[id].l) st.push_back(nodes[id].l);
+            if (nodes[id].r) st.push_back(nodes[id].r);
+            nodes.free(id);
+        }
+        t = Tree();
+    }
+
     Tree merge(Tree&& l, Tree&& r) {
         if (l.empty()) return r;
         if (r.empty()) return l;
@@ -100,6 +204,16 @@ template <acted_monoid M> struct SplayTree {
         t.id = lid;
         return Tree(rid);
     }
+    // split t at the nondecreasing positions pos, returns |pos| + 1 trees
+    std::vector<Tree> split_batch(Tree&& t, std::span<const int> pos) {
+        std::vector<Tree> v(pos.size() + 1);
+        for (auto i = std::ssize(pos) - 1; i >= 0; i--) {
+            assert(i == 0 || pos[i - 1] <= pos[i]);
+            v[i + 1] = split(t, pos[i]);
+        }
+        v[0] = t;
+        return v;
+    }
     std::array<Tree, 3> split3(Tree&& t, int l, int r) {
         assert(0 <= l && l <= r && r <= ssize(t));
         auto t3 = split(t, r);
@@ -110,14 +224,9 @@ template <acted_monoid M> struct SplayTree {
     std::vector<S> to_vec(const Tree& t) {
         std::vector<S> buf;
         buf.reserve(nodes[t.id].len);
-        auto f = [&](auto self, int id) {
-            if (id == 0) return;
-            push(id);
-            self(self, nodes[id].l);
+        for (int id : flatten(t.id)) {
             buf.push_back(nodes[id].s);
-            self(self, nodes[id].r);
-        };
-        f(f, t.id);
+        }
         return buf;
     }
 
@@ -166,16 +275,66 @@ template <acted_monoid M> struct SplayTree {
         S s, prod;
         F f;
     };
-    std::vector<Node> nodes;
+    NodeArena<Node> nodes;
+
+    // balanced tree of v, gaps (empty or |v| + 1 trees) fill the empty slots
+    int build(const std::vector<S>& v, std::span<const Tree> gaps) {
+        std::vector<int> ids(v.size());
+        for (size_t i = 0; i < v.size(); i++) {
+            ids[i] = new_node(v[i], 0, 0);
+        }
+        return link(ids, gaps);
+    }
+
+    // balanced tree whose in-order is ids, the i-th node (1-indexed) is at
+    // height countr_zero(i)
+    int link(const std::vector<int>& ids, std::span<const Tree> gaps = {}) {
+        int n = int(ids.size());
+        assert(gaps.empty() || std::ssize(gaps) == n + 1);
+        auto gap = [&](int i) { return gaps.empty() ? 0 : gaps[i].id; };
+        if (n == 0) return gap(0);
+        for (int b = 1; b <= n; b *= 2) {
+            for (int i = b; i <= n; i += 2 * b) {
+                int step = b / 2;
+                while (step && i + step > n) step /= 2;
+                Node& nd = nodes[ids[i - 1]];
+                nd.l = (b == 1) ? gap(i - 1) : ids[i - b / 2 - 1];
+                nd.r = step ? ids[i + step - 1] : gap(i);
+                update(ids[i - 1]);
+            }
+        }
+        return ids[std::bit_floor(u32(n)) - 1];
+    }
+
+    // in-order node ids, pushing all lazy values
+    std::vector<int> flatten(int id) {
+        std::vector<int> out, st;
+        while (id || !st.empty()) {
+            while (id) {
+                push(id);
+                st.push_back(id);
+                id = nodes[id].l;
+            }
+            id = st.back();
+            st.pop_back();
+            out.push_back(id);
+            id = nodes[id].r;
+        }
+        return out;
+    }
+
+    // large batches rebuild the whole tree in O(n + m) instead of m splays
+    static bool use_rebuild(size_t n, size_t m) {
+        return m * std::bit_width(n) >= n;
+    }
 
     int new_node(const S& s, int l, int r) {
-        int id = int(nodes.size());
         Node n;
         n.l = l;
         n.r = r;
         n.s = s;
         n.f = m.act.e;
-        nodes.push_back(n);
+        int id = nodes.alloc(n);
         update(id);
         return id;
     }
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <concepts>
+#include <vector>
+
+#include "yosupo/container/bitvector.hpp"
+#include "yosupo/types.hpp"
+
+namespace yosupo {
+
+// static sequence of non-negative integers
+template <std::unsigned_integral T> struct WaveletMatrix {
+  public:
+    WaveletMatrix() : WaveletMatrix(std::vector<T>()) {}
+    explicit WaveletMatrix(std::vector<T> v)
+        : _n(int(v.size())),
+          lg(int(std::bit_width(v.empty() ? T(0) : std::ranges::max(v)))) {
+        bits.resize(lg);
+        mid.resize(lg);
+        std::vector<T> nv(_n);
+        for (int h = lg - 1; h >= 0; h--) {
+            BitVec bv(_n);
+            for (int i = 0; i < _n; i++) {
+                if (v[i] >> h & 1) bv.set(i);
+            }
+            int z = 0;
+            for (int i = 0; i < _n; i++) {
+                if (!(v[i] >> h & 1)) nv[z++] = v[i];
+            }
+            mid[h] = z;
+            for (int i = 0; i < _n; i++) {
+                if (v[i] >> h & 1) nv[z++] = v[i];
+            }
+            bits[h] = SuccinctBitVec(std::move(bv));
+            std::swap(v, nv);
+        }
+    }
+
+    int size() const { return _n; }
+
+    T get(int i) const {
+        assert(0 <= i && i < _n);
+        T res = 0;
+        for (int h = lg - 1; h >= 0; h--) {
+            if (bits[h].test(i)) {
+                res |= T(1) << h;
+                i = mid[h] + int(bits[h].rank1(i));
+            } else {
+                i = int(bits[h].rank0(i));
+            }
+        }
+        return res;
+    }
+
+    // k-th (0-indexed) smallest value in a[l..r)
+    T kth_smallest(int l, int r, int k) const {
+        assert(0 <= l && l <= r && r <= _n);
+        assert(0 <= k && k < r - l);
+        T res = 0;
+        for (int h = lg - 1; h >= 0; h--) {
+            int l0 = int(bits[h].rank0(l)), r0 = int(bits[h].rank0(r));
+            if (k < r0 - l0) {
+                l = l0;
+                r = r0;
+            } else {
+                k -= r0 - l0;
+                res |= T(1) << h;
+                l = mid[h] + (l - l0);
+                r = mid[h] + (r - r0);
+            }
+        }
+        return res;
+    }
+    // k-th (0-indexed) largest value in a[l..r)
+    T kth_largest(int l, int r, int k) const {
+        return kth_smallest(l, r, r - l - 1 - k);
+    }
+    // q-quantile of a[l..r), q in [0, 1]
+    T quantile(int l, int r, double q) const {
+        assert(0 <= q && q <= 1);
+        int k = std::min(r - l - 1, int(q * (r - l)));
+        return kth_smallest(l, r, k);
+    }
+
+    // #{i in [l, r) | a[i] < upper}
+    int freq(int l, int r, T upper) const {
+        assert(0 <= l && l <= r && r <= _n);
+        if (lg < int(sizeof(T) * 8) && (upper >> lg)) return r - l;
+        int res = 0;
+        for (int h = lg - 1; h >= 0; h--) {
+            int l0 = int(bits[h].rank0(l)), r0 = int(bits[h].rank0(r));
+            if (upper >> h & 1) {
+                res += r0 - l0;
+                l = mid[h] + (l - l0);
+                r = mid[h] + (r - r0);
+            } else {
+                l = l0;
+                r = r0;
+            }
+        }
+        return res;
+    }
+    // #{i in [l, r) | lower <= a[i] < upper}
+    int freq(int l, int r, T lower, T upper) const {
+        if (lower >= upper) return 0;
+        return freq(l, r, upper) - freq(l, r, lower);
+    }
+
+  private:
+    int _n, lg;
+    std::vector<SuccinctBitVec> bits;
+    // mid[h]: #0 in bits[h]
+    std::vector<int> mid;
+};
+
+}  // namespace yosupo
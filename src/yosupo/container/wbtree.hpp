@@ -0,0 +1,433 @@
+#pragma once
+
+#include <sys/types.h>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "yosupo/algebra.hpp"
+#include "yosupo/container/arena.hpp"
+
+namespace yosupo {
+
+// Join-based weight balanced tree, all operations are worst-case O(log n)
+// get / prod / to_vec don't modify the tree
+// PERSISTENT: operations copy the touched nodes, old Trees remain valid
+// reverse swaps S::val and S::rev if S has them (e.g. ReversibleMonoid)
+template <acted_monoid M, bool PERSISTENT = false> struct WBTree {
+    using S = typename M::S;
+    using F = typename M::F;
+
+    WBTree(const M& _m) : m(_m) { reset(); }
+
+    // free all nodes, every Tree built so far becomes invalid
+    void reset() {
+        nodes.clear();
+        // last node
+        nodes.alloc(Node{
+            .l = 0,
+            .r = 0,
+            .len = 0,
+            .s = m.monoid.e,
+            .prod = m.monoid.e,
+            .f = m.act.e,
+            .rev = false,
+        });
+    }
+
+    struct Tree {
+        int id;
+        Tree() : id(0) {}
+        Tree(int _id) : id(_id) {}
+        bool empty() const { return id == 0; }
+    };
+
+    size_t size(const Tree& t) const { return nodes[t.id].len; }
+    ptrdiff_t ssize(const Tree& t) const { return size(t); }
+
+    Tree build() { return Tree(); }
+    Tree build(const S& s) { return Tree(new_node(s)); }
+    Tree build(const std::vector<S>& v) {
+        auto f = [&](auto self, int lidx, int ridx) -> int {
+            if (lidx == ridx) return 0;
+            int mid = (lidx + ridx) / 2;
+            int l = self(self, lidx, mid);
+            int r = self(self, mid + 1, ridx);
+            return make(l, new_node(v[mid]), r);
+        };
+        return Tree(f(f, 0, int(v.size())));
+    }
+
+    S get(const Tree& t, int k) {
+        assert(0 <= k && k < ssize(t));
+        int id = t.id;
+        F acc = m.act.e;
+        bool flip = false;
+        while (true) {
+            const Node& n = nodes[id];
+            auto [l, r] = children(n, flip);
+            int lsz = nodes[l].len;
+            if (k == lsz) return m.mapping(acc, n.s);
+            acc = m.act.op(acc, n.f);
+            flip ^= n.rev;
+            if (k < lsz) {
+                id = l;
+            } else {
+                k -= lsz + 1;
+                id = r;
+            }
+        }
+    }
+    void set(Tree& t, int k, const S& s) {
+        assert(0 <= k && k < ssize(t));
+        t.id = set(t.id, k, s);
+    }
+
+    void insert(Tree& t, int k, const S& s) {
+        assert(0 <= k && k <= ssize(t));
+        auto [a, b] = split(t.id, k);
+        t.id = join(a, new_node(s), b);
+    }
+    void erase(Tree& t, int k) {
+        assert(0 <= k && k < ssize(t));
+        t.id = erase(t.id, k);
+    }
+
+    Tree merge(Tree&& l, Tree&& r) { return Tree(merge(l.id, r.id)); }
+    Tree merge3(Tree&& t1, Tree&& t2, Tree&& t3) {
+        return merge(merge(std::move(t1), std::move(t2)), std::move(t3));
+    }
+    Tree split(Tree& t, int k) {
+        assert(0 <= k && k <= ssize(t));
+        auto [a, b] = split(t.id, k);
+        t.id = a;
+        return Tree(b);
+    }
+    std::array<Tree, 3> split3(Tree&& t, int l, int r) {
+        assert(0 <= l && l <= r && r <= ssize(t));
+        auto t3 = split(t, r);
+        auto t2 = split(t, l);
+        return {std::move(t), std::move(t2), std::move(t3)};
+    }
+
+    std::vector<S> to_vec(const Tree& t) {
+        std::vector<S> buf;
+        buf.reserve(nodes[t.id].len);
+        auto f = [&](auto self, int id, F acc, bool flip) -> void {
+            if (id == 0) return;
+            const Node& n = nodes[id];
+            auto [l, r] = children(n, flip);
+            F acc2 = m.act.op(acc, n.f);
+            self(self, l, acc2, flip ^ n.rev);
+            buf.push_back(m.mapping(acc, n.s));
+            self(self, r, acc2, flip ^ n.rev);
+        };
+        f(f, t.id, m.act.e, false);
+        return buf;
+    }
+
+    S all_prod(const Tree& t) const { return nodes[t.id].prod; }
+    S prod(const Tree& t, int l, int r) {
+        assert(0 <= l && l <= r && r <= ssize(t));
+        if (l == r) return m.monoid.e;
+        return prod(t.id, l, r, m.act.e, false);
+    }
+
+    void all_apply(Tree& t, const F& f) {
+        if (t.empty()) return;
+        t.id = copy(t.id);
+        all_apply(t.id, f);
+    }
+    void apply(Tree& t, int l, int r, const F& f) {
+        assert(0 <= l && l <= r && r <= ssize(t));
+        if (l == r) return;
+        t.id = apply(t.id, l, r, f);
+    }
+
+    void reverse(Tree& t) {
+        if (t.empty()) return;
+        t.id = copy(t.id);
+        reverse(t.id);
+    }
+    void reverse(Tree& t, int l, int r) {
+        assert(0 <= l && l <= r && r <= ssize(t));
+        auto [t1, t2, t3] = split3(std::move(t), l, r);
+        reverse(t2);
+        t = merge3(std::move(t1), std::move(t2), std::move(t3));
+    }
+
+    // free all nodes of t (PERSISTENT: nodes may be shared, only drop t)
+    void clear(Tree& t) {
+        if constexpr (!PERSISTENT) {
+            if (!t.empty()) {
+                std::vector<int> st = {t.id};
+                while (!st.empty()) {
+                    int id = st.back();
+                    st.pop_back();
+                    if (nodes[id].l) st.push_back(nodes[id].l);
+                    if (nodes[id].r) st.push_back(nodes[id].r);
+                    nodes.free(id);
+                }
+            }
+        }
+        t = Tree();
+    }
+
+    // number of nodes on the longest root-leaf path, O(log n) by the balance
+    int height(const Tree& t) const {
+        if (t.empty()) return 0;
+        int h = 0;
+        std::vector<std::pair<int, int>> st = {{t.id, 1}};
+        while (!st.empty()) {
+            auto [id, d] = st.back();
+            st.pop_back();
+            h = std::max(h, d);
+            if (nodes[id].l) st.push_back({nodes[id].l, d + 1});
+            if (nodes[id].r) st.push_back({nodes[id].r, d + 1});
+        }
+        return h;
+    }
+
+  private:
+    M m;
+
+    struct Node {
+        int l, r, len;
+        S s, prod;
+        F f;
+        bool rev;
+    };
+    NodeArena<Node> nodes;
+
+    int new_node(const S& s) {
+        return nodes.alloc(Node{
+            .l = 0,
+            .r = 0,
+            .len = 1,
+            .s = s,
+            .prod = s,
+            .f = m.act.e,
+            .rev = false,
+        });
+    }
+
+    // nodes reachable from other Trees must be copied before modification
+    int copy(int id) {
+        if constexpr (PERSISTENT) {
+            if (id) return nodes.alloc(nodes[id]);
+        }
+        return id;
+    }
+
+    static S reversed(S s) {
+        if constexpr (requires { s.val, s.rev; }) std::swap(s.val, s.rev);
+        return s;
+    }
+    static std::pair<int, int> children(const Node& n, bool flip) {
+        return flip ? std::pair{n.r, n.l} : std::pair{n.l, n.r};
+    }
+
+    void all_apply(int id, const F& f) {
+        if (id == 0) return;
+        Node& n = nodes[id];
+        n.s = m.mapping(f, n.s);
+        n.prod = m.mapping(f, n.prod);
+        n.f = m.act.op(f, n.f);
+    }
+    void reverse(int id) {
+        if (id == 0) return;
+        Node& n = nodes[id];
+        std::swap(n.l, n.r);
+        n.prod = reversed(n.prod);
+        n.rev = !n.rev;
+    }
+    void push(int id) {
+        Node& n = nodes[id];
+        if constexpr (std::equality_comparable<F>) {
+            if (!n.rev && n.f == m.act.e) return;
+        }
+        n.l = copy(n.l);
+        n.r = copy(n.r);
+        if (n.rev) {
+            reverse(n.l);
+            reverse(n.r);
+            n.rev = false;
+        }
+        all_apply(n.l, n.f);
+        all_apply(n.r, n.f);
+        n.f = m.act.e;
+    }
+    void update(int id) {
+        Node& n = nodes[id];
+        n.len = nodes[n.l].len + 1 + nodes[n.r].len;
+        n.prod =
+            m.monoid.op(m.monoid.op(nodes[n.l].prod, n.s), nodes[n.r].prod);
+    }
+
+    // k: owned node without lazy values
+    int make(int l, int k, int r) {
+        nodes[k].l = l;
+        nodes[k].r = r;
+        update(k);
+        return k;
+    }
+
+    long long weight(int id) const { return nodes[id].len + 1; }
+    // alpha = 1/4
+    static bool like(long long a, long long b) {
+        return 3 * a >= b && 3 * b >= a;
+    }
+
+    int rotate_left(int id) {
+        int r = copy(nodes[id].r);
+        push(r);
+        nodes[id].r = nodes[r].l;
+        update(id);
+        return make(id, r, nodes[r].r);
+    }
+    int rotate_right(int id) {
+        int l = copy(nodes[id].l);
+        push(l);
+        nodes[id].l = nodes[l].r;
+        update(id);
+        return make(nodes[l].l, l, id);
+    }
+
+    int join_right(int l, int k, int r) {
+        if (like(weight(l), weight(r))) return make(l, k, r);
+        l = copy(l);
+        push(l);
+        int ll = nodes[l].l;
+        int t = join_right(nodes[l].r, k, r);
+        if (like(weight(ll), weight(t))) return make(ll, l, t);
+        int tl = nodes[t].l, tr = nodes[t].r;
+        if (like(weight(ll), weight(tl)) &&
+            like(weight(ll) + weight(tl), weight(tr))) {
+            return rotate_left(make(ll, l, t));
+        }
+        return rotate_left(make(ll, l, rotate_right(t)));
+    }
+    int join_left(int l, int k, int r) {
+        if (like(weight(l), weight(r))) return make(l, k, r);
+        r = copy(r);
+        push(r);
+        int rr = nodes[r].r;
+        int t = join_left(l, k, nodes[r].l);
+        if (like(weight(t), weight(rr))) return make(t, r, rr);
+        int tl = nodes[t].l, tr = nodes[t].r;
+        if (like(weight(tr), weight(rr)) &&
+            like(weight(tl), weight(tr) + weight(rr))) {
+            return rotate_right(make(t, r, rr));
+        }
+        return rotate_right(make(rotate_left(t), r, rr));
+    }
+    int join(int l, int k, int r) {
+        if (weight(l) > 3 * weight(r)) return join_right(l, k, r);
+        if (weight(r) > 3 * weight(l)) return join_left(l, k, r);
+        return make(l, k, r);
+    }
+
+    // (rest, last node)
+    std::pair<int, int> split_last(int id) {
+        id = copy(id);
+        push(id);
+        if (nodes[id].r == 0) return {nodes[id].l, id};
+        auto [a, b] = split_last(nodes[id].r);
+        return {join(nodes[id].l, id, a), b};
+    }
+    int merge(int l, int r) {
+        if (l == 0) return r;
+        if (r == 0) return l;
+        auto [a, k] = split_last(l);
+        return join(a, k, r);
+    }
+    std::pair<int, int> split(int id, int k) {
+        if (k == 0) return {0, id};
+        if (k == nodes[id].len) return {id, 0};
+        id = copy(id);
+        push(id);
+        int l = nodes[id].l, r = nodes[id].r;
+        int lsz = nodes[l].len;
+        if (k <= lsz) {
+            auto [a, b] = split(l, k);
+            return {a, join(b, id, r)};
+        } else {
+            auto [a, b] = split(r, k - lsz - 1);
+            return {join(l, id, a), b};
+        }
+    }
+
+    int set(int id, int k, const S& s) {
+        id = copy(id);
+        push(id);
+        Node& n = nodes[id];
+        int lsz = nodes[n.l].len;
+        if (k < lsz) {
+            n.l = set(n.l, k, s);
+        } else if (k == lsz) {
+            n.s = s;
+        } else {
+            n.r = set(n.r, k - lsz - 1, s);
+        }
+        update(id);
+        return id;
+    }
+    int erase(int id, int k) {
+        id = copy(id);
+        push(id);
+        int l = nodes[id].l, r = nodes[id].r;
+        int lsz = nodes[l].len;
+        if (k == lsz) {
+            if constexpr (!PERSISTENT) nodes.free(id);
+            return merge(l, r);
+        }
+        if (k < lsz) return join(erase(l, k), id, r);
+        return join(l, id, erase(r, k - lsz - 1));
+    }
+
+    // acc: pending act for id, flip: whether id is reversed
+    S prod(int id, int l, int r, const F& acc, bool flip) {
+        const Node& n = nodes[id];
+        if (l == 0 && r == n.len) {
+            return m.mapping(acc, flip ? reversed(n.prod) : n.prod);
+        }
+        auto [cl, cr] = children(n, flip);
+        F acc2 = m.act.op(acc, n.f);
+        bool flip2 = flip ^ n.rev;
+        int lsz = nodes[cl].len;
+        S s = m.monoid.e;
+        if (l < lsz) s = prod(cl, l, std::min(r, lsz), acc2, flip2);
+        if (l <= lsz && lsz < r) s = m.monoid.op(s, m.mapping(acc, n.s));
+        if (lsz + 1 < r) {
+            s = m.monoid.op(s, prod(cr, std::max(l - lsz - 1, 0),
+                                    r - lsz - 1, acc2, flip2));
+        }
+        return s;
+    }
+    int apply(int id, int l, int r, const F& f) {
+        id = copy(id);
+        Node& n = nodes[id];
+        if (l == 0 && r == n.len) {
+            all_apply(id, f);
+            return id;
+        }
+        push(id);
+        int lsz = nodes[n.l].len;
+        if (l < lsz) n.l = apply(n.l, l, std::min(r, lsz), f);
+        if (l <= lsz && lsz < r) n.s = m.mapping(f, n.s);
+        if (lsz + 1 < r) {
+            n.r = apply(n.r, std::max(l - lsz - 1, 0), r - lsz - 1, f);
+        }
+        update(id);
+        return id;
+    }
+};
+
+template <acted_monoid M> using PersistentWBTree = WBTree<M, true>;
+
+}  // namespace yosupo
@@ -0,0 +1,206 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <concepts>
+#include <utility>
+#include <vector>
+
+#include "yosupo/container/hashmap.hpp"
+#include "yosupo/hash.hpp"
+#include "yosupo/types.hpp"
+
+namespace yosupo {
+
+// frequency estimation, estimate(k) >= (true count of k)
+// memory: DEPTH * 2^width_log counters
+// merge requires the same hasher, i.e. copy an empty sketch or pass the same
+// seed Hasher{a, b} to both constructors
+template <class K, int DEPTH = 4, class H = Hasher> struct CountMinSketch {
+    static_assert(1 <= DEPTH);
+
+  public:
+    explicit CountMinSketch(int _width_log = 16, const H& _h = H())
+        : h(_h), width_log(_width_log), table(size_t(DEPTH) << width_log) {
+        assert(1 <= width_log && width_log <= 32);
+    }
+
+    void add(const K& k, u64 c = 1) {
+        auto idx = indices(k);
+        for (int i = 0; i < DEPTH; i++) table[idx[i]] += c;
+    }
+
+    // conservative update: increase each counter only up to estimate + c
+    void add_conservative(const K& k, u64 c = 1) {
+        auto idx = indices(k);
+        u64 est = min_counter(idx);
+        for (int i = 0; i < DEPTH; i++) {
+            table[idx[i]] = std::max(table[idx[i]], est + c);
+        }
+    }
+
+    u64 estimate(const K& k) const { return min_counter(indices(k)); }
+
+    void merge(const CountMinSketch& rhs) {
+        assert(width_log == rhs.width_log);
+        if constexpr (std::same_as<H, Hasher>) {
+            assert(h.a == rhs.h.a && h.b == rhs.h.b);
+        }
+        for (size_t i = 0; i < table.size(); i++) table[i] += rhs.table[i];
+    }
+
+  private:
+    H h;
+    int width_log;
+    // table[(i << width_log) + j]: row i, column j
+    std::vector<u64> table;
+
+    // double hashing: column of row i is h1 + i * h2
+    std::array<size_t, DEPTH> indices(const K& k) const {
+        u64 x = h(k);
+        u64 h1 = x, h2 = (x >> 32 | x << 32) | 1;
+        u64 mask = (u64(1) << width_log) - 1;
+        std::array<size_t, DEPTH> idx;
+        for (int i = 0; i < DEPTH; i++) {
+            idx[i] = (size_t(i) << width_log) + ((h1 + i * h2) & mask);
+        }
+        return idx;
+    }
+
+    u64 min_counter(const std::array<size_t, DEPTH>& idx) const {
+        u64 est = table[idx[0]];
+        for (int i = 1; i < DEPTH; i++) est = std::min(est, table[idx[i]]);
+        return est;
+    }
+};
+
+// top-k heavy hitters with capacity counters (Space-Saving)
+// count - error <= (true count) <= count for tracked keys
+template <class K, class H = Hasher> struct SpaceSaving {
+  public:
+    struct Entry {
+        K key;
+        u64 count, error;
+    };
+
+    explicit SpaceSaving(int _capacity, const H& _h = H())
+        : capacity(_capacity), pos(_h) {
+        assert(capacity >= 1);
+        pos.reserve(capacity);
+    }
+
+    void add(const K& k, u64 c = 1) {
+        auto it = pos.find(k);
+        if (it != pos.end()) {
+            int i = it->second;
+            heap[i].count += c;
+            down(i);
+            return;
+        }
+        if (int(heap.size()) < capacity) {
+            heap.push_back({k, c, 0});
+            pos[k] = int(heap.size()) - 1;
+            up(int(heap.size()) - 1);
+            return;
+        }
+        // replace the minimum
+        pos.erase(heap[0].key);
+        u64 mn = heap[0].count;
+        heap[0] = {k, mn + c, mn};
+        pos[k] = 0;
+        down(0);
+    }
+
+    // upper bound of the count
+    u64 estimate(const K& k) const {
+        auto it = pos.find(k);
+        if (it != pos.end()) return heap[it->second].count;
+        return min_count();
+    }
+
+    // tracked keys, in descending order of count
+    std::vector<Entry> top() const {
+        auto res = heap;
+        std::ranges::sort(res, [](const Entry& a, const Entry& b) {
+            return a.count > b.count;
+        });
+        return res;
+    }
+
+    // requires the same capacity
+    void merge(const SpaceSaving& rhs) {
+        assert(capacity == rhs.capacity);
+        u64 mn = min_count(), rmn = rhs.min_count();
+        std::vector<Entry> all;
+        for (auto e : heap) {
+            auto it = rhs.pos.find(e.key);
+            if (it != rhs.pos.end()) {
+                const auto& f = rhs.heap[it->second];
+                e.count += f.count;
+                e.error += f.error;
+            } else {
+                e.count += rmn;
+                e.error += rmn;
+            }
+            all.push_back(e);
+        }
+        for (auto e : rhs.heap) {
+            if (pos.contains(e.key)) continue;
+            e.count += mn;
+            e.error += mn;
+            all.push_back(e);
+        }
+        std::ranges::sort(all, [](const Entry& a, const Entry& b) {
+            return a.count > b.count;
+        });
+        if (int(all.size()) > capacity) all.resize(capacity);
+
+        for (const auto& e : heap) pos.erase(e.key);
+        heap.clear();
+        for (const auto& e : all) {
+            heap.push_back(e);
+            pos[e.key] = int(heap.size()) - 1;
+            up(int(heap.size()) - 1);
+        }
+    }
+
+  private:
+    int capacity;
+    // min-heap by count
+    std::vector<Entry> heap;
+    IncrementalHashMap<K, int, H> pos;
+
+    u64 min_count() const {
+        return int(heap.size()) < capacity ? 0 : heap[0].count;
+    }
+
+    void swap_node(int i, int j) {
+        std::swap(heap[i], heap[j]);
+        pos[heap[i].key] = i;
+        pos[heap[j].key] = j;
+    }
+    void up(int i) {
+        while (i > 0 && heap[(i - 1) / 2].count > heap[i].count) {
+            swap_node(i, (i - 1) / 2);
+            i = (i - 1) / 2;
+        }
+    }
+    void down(int i) {
+        int n = int(heap.size());
+        while (true) {
+            int j = i;
+            if (2 * i + 1 < n && heap[2 * i + 1].count < heap[j].count) {
+                j = 2 * i + 1;
+            }
+            if (2 * i + 2 < n && heap[2 * i + 2].count < heap[j].count) {
+                j = 2 * i + 2;
+            }
+            if (j == i) return;
+            swap_node(i, j);
+            i = j;
+        }
+    }
+};
+
+}  // namespace yosupo
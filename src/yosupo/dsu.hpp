@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <cassert>
 #include <utility>
 #include <vector>
@@ -30,8 +31,8 @@ struct RollbackDSU {
 
     int leader(int a) {
         assert(0 <= a && a < n);
-        if (parent_or_size[a] < 0) return a;
-        return leader(parent_or_size[a]);
+        while (parent_or_size[a] >= 0) a = parent_or_size[a];
+        return a;
     }
 
     int size(int a) {
@@ -40,8 +41,15 @@ struct RollbackDSU {
     }
 
     template <class F> void with(F f) {
-        int checkpoint = int(history.size());
+        int checkpoint = snapshot();
         f();
+        rollback(checkpoint);
+    }
+
+    // rollback(snapshot()) undoes the merges done in between
+    int snapshot() const { return int(history.size()); }
+    void rollback(int checkpoint) {
+        assert(0 <= checkpoint && checkpoint <= int(history.size()));
         while (int(history.size()) > checkpoint) {
             auto [idx, val] = history.back();
             history.pop_back();
@@ -57,4 +65,60 @@ struct RollbackDSU {
     std::vector<std::pair<int, int>> history;
 };
 
+// thread-safe lock-free union-find
+// merge links the root with the smaller index under the other one by CAS,
+// leader uses path halving
+struct ConcurrentDSU {
+    explicit ConcurrentDSU(int _n) : n(_n), par(n) {
+        for (int i = 0; i < n; i++) par[i].store(i, std::memory_order_relaxed);
+    }
+
+    // @return true if a and b were in different sets
+    bool merge(int a, int b) {
+        assert(0 <= a && a < n);
+        assert(0 <= b && b < n);
+        while (true) {
+            a = leader(a);
+            b = leader(b);
+            if (a == b) return false;
+            if (a > b) std::swap(a, b);
+            int expected = a;
+            if (par[a].compare_exchange_strong(expected, b,
+                                               std::memory_order_acq_rel)) {
+                return true;
+            }
+        }
+    }
+
+    bool same(int a, int b) {
+        assert(0 <= a && a < n);
+        assert(0 <= b && b < n);
+        while (true) {
+            a = leader(a);
+            b = leader(b);
+            if (a == b) return true;
+            // a is still a root, so a and b were in different sets
+            if (par[a].load(std::memory_order_acquire) == a) return false;
+        }
+    }
+
+    int leader(int a) {
+        assert(0 <= a && a < n);
+        while (true) {
+            int p = par[a].load(std::memory_order_acquire);
+            if (p == a) return a;
+            int g = par[p].load(std::memory_order_acquire);
+            if (p != g) {
+                // failure is fine, someone else moved a upward
+                par[a].compare_exchange_weak(p, g, std::memory_order_relaxed);
+            }
+            a = g;
+        }
+    }
+
+  private:
+    int n;
+    std::vector<std::atomic<int>> par;
+};
+
 }  // namespace yosupo
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <utility>
+#include <vector>
+
+#include "yosupo/dsu.hpp"
+#include "yosupo/flattenvector.hpp"
+#include "yosupo/types.hpp"
+
+namespace yosupo {
+
+// Offline connectivity with edge insertions / deletions
+// Divide and conquer over time with RollbackDSU, O(m log q log n)
+struct OfflineDynamicConnectivity {
+    explicit OfflineDynamicConnectivity(int _n) : n(_n) {}
+
+    void add_edge(int u, int v) { push_edge(u, v, true); }
+    // (u, v) must exist now
+    void erase_edge(int u, int v) { push_edge(u, v, false); }
+    // is u connected to v now, answered by solve()
+    void same(int u, int v) {
+        assert(0 <= u && u < n);
+        assert(0 <= v && v < n);
+        queries.push_back({u, v});
+    }
+
+    // the answers of same() in order
+    std::vector<bool> solve() {
+        int q = int(queries.size());
+        if (q == 0) return {};
+
+        // each edge is alive for the queries in [l, r)
+        struct Span {
+            int u, v, l, r;
+        };
+        std::vector<Span> spans;
+        // events of the same edge keep their order
+        std::ranges::stable_sort(events, {}, &Event::key);
+        std::vector<int> open;
+        for (size_t i = 0; i < events.size(); i++) {
+            const auto& e = events[i];
+            if (e.add) {
+                open.push_back(e.time);
+            } else {
+                assert(!open.empty());
+                spans.push_back({int(e.key >> 32), int(u32(e.key)),
+                                 open.back(), e.time});
+                open.pop_back();
+            }
+            if (i + 1 == events.size() || events[i + 1].key != e.key) {
+                for (int l : open) {
+                    spans.push_back({int(e.key >> 32), int(u32(e.key)), l, q});
+                }
+                open.clear();
+            }
+        }
+
+        // segment tree over the queries, node k has the edges alive in
+        // its whole range
+        int lg = std::countr_zero(std::bit_ceil(u32(q)));
+        int size = 1 << lg;
+        FlattenVector<std::pair<int, int>> edges(2 * size, [&](auto f) {
+            for (const auto& s : spans) {
+                int l = s.l + size, r = s.r + size;
+                while (l < r) {
+                    if (l & 1) f(l++, std::pair(s.u, s.v));
+                    if (r & 1) f(--r, std::pair(s.u, s.v));
+                    l >>= 1;
+                    r >>= 1;
+                }
+            }
+        });
+
+        // non-recursive dfs, saved[d]: snapshot before entering depth d
+        std::vector<bool> ans(q);
+        RollbackDSU dsu(n);
+        std::vector<int> saved(lg + 1);
+        auto depth = [&](int k) { return std::bit_width(u32(k)) - 1; };
+        int k = 1;
+        while (true) {
+            int d = depth(k);
+            saved[d] = dsu.snapshot();
+            for (auto [u, v] : edges.at(k)) dsu.merge(u, v);
+            if (k < size) {
+                // skip the subtrees without queries
+                if ((k << (lg - d)) - size < q) {
+                    k = 2 * k;
+                    continue;
+                }
+            } else if (k - size < q) {
+                auto [u, v] = queries[k - size];
+                ans[k - size] = dsu.same(u, v);
+            }
+            // go to the next subtree
+            while (k & 1) {
+                dsu.rollback(saved[depth(k)]);
+                k >>= 1;
+            }
+            if (k == 0) break;
+            dsu.rollback(saved[depth(k)]);
+            k++;
+        }
+        return ans;
+    }
+
+  private:
+    int n;
+    struct Event {
+        // (min(u, v) << 32) | max(u, v)
+        u64 key;
+        // the number of queries before this event
+        int time;
+        bool add;
+    };
+    std::vector<Event> events;
+    std::vector<std::pair<int, int>> queries;
+
+    void push_edge(int u, int v, bool add) {
+        assert(0 <= u && u < n);
+        assert(0 <= v && v < n);
+        if (u > v) std::swap(u, v);
+        events.push_back({(u64(u) << 32) | u64(v), int(queries.size()), add});
+    }
+};
+
+}  // namespace yosupo
@@ -0,0 +1,291 @@
+#pragma once
+
+#include <cassert>
+#include <utility>
+#include <vector>
+
+#include "yosupo/algebra.hpp"
+
+namespace yosupo {
+
+// Link-cut tree whose virtual children are kept in splay trees (rake trees),
+// so Point doesn't need an inverse. Each tree has a current root.
+template <static_top_tree_dp TreeDP> struct DynamicTopTree {
+    using Point = typename TreeDP::Point;
+    using Path = typename TreeDP::Path;
+    using Vertex = typename TreeDP::Vertex;
+
+    int n;
+
+    // n isolated vertices
+    DynamicTopTree(std::vector<Vertex> _vertices, const TreeDP& _dp = TreeDP())
+        : n(int(_vertices.size())),
+          vertices(std::move(_vertices)),
+          dp(_dp),
+          nodes(n + 1,
+                Node{.agg = dp.path.e, .ragg = dp.path.e, .rsum = dp.point.e}) {
+        for (int i = 1; i <= n; i++) update(i);
+    }
+
+    Vertex get_vertex(int u) { return vertices[u]; }
+    void update(int u, Vertex vertex) {
+        int x = u + 1;
+        access(x);
+        vertices[u] = vertex;
+        update(x);
+    }
+
+    // make u the root of its tree
+    void evert(int u) {
+        int x = u + 1;
+        access(x);
+        toggle(x);
+    }
+    // root of the tree containing u
+    int root(int u) {
+        int x = u + 1;
+        access(x);
+        while (true) {
+            push(x);
+            if (!nodes[x].l) break;
+            x = nodes[x].l;
+        }
+        splay(x);
+        return x - 1;
+    }
+
+    // u and v must be in different trees, the root of u's tree becomes u
+    void link(int u, int v) {
+        assert(root(u) != root(v));
+        int x = u + 1, y = v + 1;
+        evert(u);
+        access(y);
+        rake_insert(y, x);
+        update(y);
+    }
+    // (u, v) must be an edge, the root of u's tree becomes u
+    void cut(int u, int v) {
+        int x = u + 1, y = v + 1;
+        evert(u);
+        access(y);
+        assert(nodes[y].l == x && !nodes[x].r);
+        nodes[y].l = 0;
+        nodes[x].p = 0;
+        update(y);
+    }
+
+    // same as StaticTopTree: the whole tree / the path from the root to u
+    // (u's subtree is folded into u) / the subtree of u
+    Point all_prod(int u) {
+        int x = u + 1;
+        access(x);
+        return dp.add_edge(nodes[x].agg);
+    }
+    Path path_prod(int u) {
+        int x = u + 1;
+        access(x);
+        return nodes[x].agg;
+    }
+    Point subtree_prod(int u) {
+        int x = u + 1;
+        access(x);
+        return dp.add_edge(dp.add_vertex(light(x), vertices[u]));
+    }
+    // the path u -> v, v's subtree (rooted at u) is folded into v
+    // the root of the tree doesn't change
+    Path path_prod(int u, int v) {
+        int r = root(u);
+        evert(u);
+        Path x = path_prod(v);
+        evert(r);
+        return x;
+    }
+
+  private:
+    std::vector<Vertex> vertices;
+    TreeDP dp;
+
+    // node x represents vertex x - 1, node 0 is null
+    struct Node {
+        // path splay tree, in order from the root side
+        int l = 0, r = 0, p = 0;
+        bool rev = false;
+        // rake splay tree, only path splay roots belong to one
+        // owner: the vertex having this rake tree (set on its root)
+        int rl = 0, rr = 0, rp = 0, owner = 0;
+        // root of the rake tree of this vertex's virtual children
+        int rake = 0;
+        Path agg, ragg;
+        Point rsum;
+    };
+    std::vector<Node> nodes;
+
+    Point light(int x) {
+        int rk = nodes[x].rake;
+        return rk ? nodes[rk].rsum : dp.point.e;
+    }
+    void update(int x) {
+        Node& nd = nodes[x];
+        Path mid = dp.add_vertex(light(x), vertices[x - 1]);
+        nd.agg = dp.path.op(dp.path.op(nodes[nd.l].agg, mid), nodes[nd.r].agg);
+        nd.ragg =
+            dp.path.op(dp.path.op(nodes[nd.r].ragg, mid), nodes[nd.l].ragg);
+    }
+    void rake_update(int x) {
+        Node& nd = nodes[x];
+        nd.rsum = dp.point.op(
+            dp.point.op(nodes[nd.rl].rsum, dp.add_edge(nd.agg)),
+            nodes[nd.rr].rsum);
+    }
+
+    void toggle(int x) {
+        if (!x) return;
+        Node& nd = nodes[x];
+        std::swap(nd.l, nd.r);
+        std::swap(nd.agg, nd.ragg);
+        nd.rev = !nd.rev;
+    }
+    void push(int x) {
+        if (!nodes[x].rev) return;
+        toggle(nodes[x].l);
+        toggle(nodes[x].r);
+        nodes[x].rev = false;
+    }
+
+    void rotate(int x) {
+        int y = nodes[x].p, z = nodes[y].p;
+        if (z) (nodes[z].l == y ? nodes[z].l : nodes[z].r) = x;
+        nodes[x].p = z;
+        if (nodes[y].l == x) {
+            nodes[y].l = nodes[x].r;
+            if (nodes[y].l) nodes[nodes[y].l].p = y;
+            nodes[x].r = y;
+        } else {
+            nodes[y].r = nodes[x].l;
+            if (nodes[y].r) nodes[nodes[y].r].p = y;
+            nodes[x].l = y;
+        }
+        nodes[y].p = x;
+        update(y);
+        update(x);
+    }
+    void splay(int x) {
+        static std::vector<int> st;
+        st.clear();
+        for (int y = x; y; y = nodes[y].p) st.push_back(y);
+        int r = st.back();
+        for (auto i = std::ssize(st) - 1; i >= 0; i--) push(st[i]);
+        while (int y = nodes[x].p) {
+            int z = nodes[y].p;
+            if (z) rotate((nodes[y].l == x) == (nodes[z].l == y) ? y : x);
+            rotate(x);
+        }
+        if (r != x) transfer(r, x);
+    }
+    // x takes over the place of r in the rake tree
+    void transfer(int r, int x) {
+        Node &a = nodes[r], &b = nodes[x];
+        if (!a.rp && !a.owner) return;
+        b.rl = std::exchange(a.rl, 0);
+        b.rr = std::exchange(a.rr, 0);
+        b.rp = std::exchange(a.rp, 0);
+        b.owner = std::exchange(a.owner, 0);
+        if (b.rl) nodes[b.rl].rp = x;
+        if (b.rr) nodes[b.rr].rp = x;
+        if (b.rp) {
+            Node& c = nodes[b.rp];
+            (c.rl == r ? c.rl : c.rr) = x;
+        }
+        if (b.owner) nodes[b.owner].rake = x;
+        rake_update(x);
+    }
+
+    void rake_rotate(int x) {
+        int y = nodes[x].rp, z = nodes[y].rp;
+        if (z) {
+            (nodes[z].rl == y ? nodes[z].rl : nodes[z].rr) = x;
+        } else {
+            nodes[x].owner = std::exchange(nodes[y].owner, 0);
+            if (nodes[x].owner) nodes[nodes[x].owner].rake = x;
+        }
+        nodes[x].rp = z;
+        if (nodes[y].rl == x) {
+            nodes[y].rl = nodes[x].rr;
+            if (nodes[y].rl) nodes[nodes[y].rl].rp = y;
+            nodes[x].rr = y;
+        } else {
+            nodes[y].rr = nodes[x].rl;
+            if (nodes[y].rr) nodes[nodes[y].rr].rp = y;
+            nodes[x].rl = y;
+        }
+        nodes[y].rp = x;
+        rake_update(y);
+        rake_update(x);
+    }
+    void rake_splay(int x) {
+        while (int y = nodes[x].rp) {
+            int z = nodes[y].rp;
+            if (z) {
+                rake_rotate((nodes[y].rl == x) == (nodes[z].rl == y) ? y : x);
+            }
+            rake_rotate(x);
+        }
+    }
+    // x: path splay root
+    void rake_insert(int w, int x) {
+        Node& nd = nodes[x];
+        nd.rl = std::exchange(nodes[w].rake, x);
+        if (nd.rl) {
+            nodes[nd.rl].rp = x;
+            nodes[nd.rl].owner = 0;
+        }
+        nd.rr = nd.rp = 0;
+        nd.owner = w;
+        rake_update(x);
+    }
+    // x: root of the rake tree of w
+    void rake_erase(int w, int x) {
+        Node& nd = nodes[x];
+        int l = std::exchange(nd.rl, 0), r = std::exchange(nd.rr, 0);
+        nd.owner = 0;
+        if (l) nodes[l].rp = 0;
+        if (r) nodes[r].rp = 0;
+        int root = r;
+        if (l) {
+            root = l;
+            while (nodes[root].rr) root = nodes[root].rr;
+            rake_splay(root);
+            nodes[root].rr = r;
+            if (r) nodes[r].rp = root;
+            rake_update(root);
+        }
+        nodes[w].rake = root;
+        if (root) nodes[root].owner = w;
+    }
+    // the vertex that x's path hangs from
+    int owner_of(int x) {
+        if (!nodes[x].rp && !nodes[x].owner) return 0;
+        rake_splay(x);
+        return nodes[x].owner;
+    }
+
+    void access(int x) {
+        int last = 0;
+        for (int y = x; y;) {
+            splay(y);
+            if (last) rake_erase(y, last);
+            if (int c = nodes[y].r) {
+                nodes[c].p = 0;
+                rake_insert(y, c);
+            }
+            nodes[y].r = last;
+            if (last) nodes[last].p = y;
+            update(y);
+            last = y;
+            y = owner_of(y);
+        }
+        splay(x);
+    }
+};
+
+}  // namespace yosupo
@@ -1,38 +1,110 @@
 #pragma once
 
-#include <ranges>
+#include <algorithm>
+#include <cassert>
+#include <concepts>
+#include <functional>
+#include <span>
+#include <thread>
 #include <utility>
 #include <vector>
 
+#include "yosupo/types.hpp"
+
 namespace yosupo {
 
+// T = bool is not supported, at() returns std::span
 template <class T> struct FlattenVector {
+    static_assert(!std::same_as<T, bool>, "use FlattenVector<char> instead");
+
     std::vector<T> v;
     std::vector<int> start;
-    FlattenVector(int n, const std::vector<std::pair<int, T>>& _v)
+    FlattenVector(int n,
+                  const std::vector<std::pair<int, T>>& _v,
+                  int threads = 1)
         : start(n + 1) {
+        if (threads > 1) {
+            build_parallel(
+                [&](int t, auto f) {
+                    for (size_t i = _v.size() * t / threads;
+                         i < _v.size() * (t + 1) / threads; i++) {
+                        f(_v[i].first, _v[i].second);
+                    }
+                },
+                threads);
+            return;
+        }
         for (const auto& x : _v) {
             start[x.first + 1]++;
         }
-        for (int i = 1; i <= n; i++) {
-            start[i] += start[i - 1];
+        build_start();
+        for (const auto& x : _v) {
+            v[start[x.first]++] = x.second;
+        }
+        shift_start();
+    }
+    FlattenVector(int n, std::vector<std::pair<int, T>>&& _v, int threads = 1)
+        : start(n + 1) {
+        if (threads > 1) {
+            build_parallel(
+                [&](int t, auto f) {
+                    for (size_t i = _v.size() * t / threads;
+                         i < _v.size() * (t + 1) / threads; i++) {
+                        f(_v[i].first, std::move(_v[i].second));
+                    }
+                },
+                threads);
+            _v = std::vector<std::pair<int, T>>();
+            return;
         }
-        v = std::vector<T>(start[n]);
-
-        auto pos = start;
         for (const auto& x : _v) {
-            v[pos[x.first]] = x.second;
-            pos[x.first]++;
+            start[x.first + 1]++;
+        }
+        build_start();
+        for (auto& x : _v) {
+            v[start[x.first]++] = std::move(x.second);
         }
+        shift_start();
+        _v = std::vector<std::pair<int, T>>();
+    }
+    // gen(f) must call f(i, x) for each element x of row i
+    // gen is called twice and must emit the same elements both times
+    template <class G>
+        requires std::invocable<G&, std::function<void(int, T)>>
+    FlattenVector(int n, G gen) : start(n + 1) {
+        gen([&](int i, const T&) { start[i + 1]++; });
+        build_start();
+        gen([&](int i, T x) { v[start[i]++] = std::move(x); });
+        shift_start();
+    }
+    // gen(t, f) must call f(i, x) for each element x of row i in part t
+    // part t (0 <= t < threads) is generated by the t-th thread, twice
+    // elements of a row are ordered by part, then by the order of gen
+    template <class G>
+        requires std::invocable<G&, int, std::function<void(int, T)>>
+    FlattenVector(int n, G gen, int threads) : start(n + 1) {
+        build_parallel(gen, threads);
     }
 
-    auto at(int i) {
-        return v | std::ranges::views::take(start[i + 1]) |
-               std::ranges::views::drop(start[i]);
+    // CSR: row i is v[start[i]..start[i + 1])
+    FlattenVector(std::vector<int> _start, std::vector<T> _v)
+        : v(std::move(_v)), start(std::move(_start)) {
+        assert(!start.empty() && start.back() == int(v.size()));
     }
-    auto at(int i) const {
-        return v | std::ranges::views::take(start[i + 1]) |
-               std::ranges::views::drop(start[i]);
+
+    std::span<T> at(int i) {
+        return {v.data() + start[i], v.data() + start[i + 1]};
+    }
+    std::span<const T> at(int i) const {
+        return {v.data() + start[i], v.data() + start[i + 1]};
+    }
+
+    // sort each row
+    template <class Comp = std::less<>> void sort_rows(Comp comp = Comp()) {
+        int n = int(start.size()) - 1;
+        for (int i = 0; i < n; i++) {
+            std::sort(v.begin() + start[i], v.begin() + start[i + 1], comp);
+        }
     }
 
     template <class Pred> int erase_if(Pred pred) {
@@ -57,6 +129,66 @@ template <class T> struct FlattenVector {
         v.resize(start[n]);
         return removed;
     }
+
+  private:
+    template <class F> static void run(int threads, F f) {
+        std::vector<std::thread> workers;
+        for (int t = 1; t < threads; t++) workers.emplace_back(f, t);
+        f(0);
+        for (auto& w : workers) w.join();
+    }
+
+    // counting sort, each thread has its own n counters
+    template <class G> void build_parallel(G gen, int threads) {
+        assert(threads >= 1);
+        int n = int(start.size()) - 1;
+        auto lw = [&](int t) { return int(i64(n) * t / threads); };
+        // cnt[t][i]: the number of elements of row i in part t
+        // -> the position of the next one
+        std::vector<std::vector<int>> cnt(threads);
+        run(threads, [&](int t) {
+            cnt[t] = std::vector<int>(n);
+            gen(t, [&](int i, const T&) { cnt[t][i]++; });
+        });
+        // rows are split among threads, sum[t]: the elements of them
+        std::vector<int> sum(threads + 1);
+        run(threads, [&](int t) {
+            for (int i = lw(t); i < lw(t + 1); i++) {
+                for (int s = 0; s < threads; s++) sum[t + 1] += cnt[s][i];
+            }
+        });
+        for (int t = 0; t < threads; t++) sum[t + 1] += sum[t];
+        run(threads, [&](int t) {
+            int pos = sum[t];
+            for (int i = lw(t); i < lw(t + 1); i++) {
+                start[i] = pos;
+                for (int s = 0; s < threads; s++) {
+                    pos += std::exchange(cnt[s][i], pos);
+                }
+            }
+        });
+        start[n] = sum[threads];
+        v = std::vector<T>(start[n]);
+        run(threads, [&](int t) {
+            gen(t, [&](int i, T x) { v[cnt[t][i]++] = std::move(x); });
+        });
+    }
+
+    // start[i + 1]: size of row i -> start[i]: begin of row i
+    void build_start() {
+        int n = int(start.size()) - 1;
+        for (int i = 1; i <= n; i++) {
+            start[i] += start[i - 1];
+        }
+        v = std::vector<T>(start[n]);
+    }
+    // start[i] was used as the cursor of row i, and now is the end of row i
+    void shift_start() {
+        for (int i = int(start.size()) - 1; i >= 1; i--) {
+            start[i] = start[i - 1];
+        }
+        start[0] = 0;
+    }
 };
 
 }  // namespace yosupo
@@ -1,10 +1,13 @@
 #pragma once
 
 #include <array>
+#include <cassert>
 #include <concepts>
 #include <cstddef>
+#include <cstring>
 #include <map>
 #include <set>
+#include <span>
 #include <string>
 #include <tuple>
 #include <utility>
@@ -27,6 +30,27 @@ struct Hasher {
 
     auto update64(u64 x) { a = wymix(a ^ x, MULTIPLE); }
 
+    // raw bytes, the caller must hash the length separately
+    void update_bytes(const char* p, size_t n) {
+        size_t i = 0;
+        if (n >= 32) {
+            // 4 independent chains for instruction-level parallelism
+            u64 l[4] = {a, a + 1, a + 2, a + 3};
+            for (; i + 32 <= n; i += 32) {
+                for (int j = 0; j < 4; j++) {
+                    l[j] = wymix(l[j] ^ load64(p + i + 8 * j), MULTIPLE);
+                }
+            }
+            for (int j = 0; j < 4; j++) update64(l[j]);
+        }
+        for (; i + 8 <= n; i += 8) update64(load64(p + i));
+        if (i < n) {
+            u64 x = 0;
+            std::memcpy(&x, p + i, n - i);
+            update64(x);
+        }
+    }
+
     u64 digest() { return wymix(a, b); }
 
     template <std::integral T>
@@ -63,18 +87,20 @@ struct Hasher {
     // vector
     template <class T> auto update(const std::vector<T>& x) {
         update(x.size());
-        for (const auto& y : x) {
-            update(y);
+        if constexpr (std::integral<T> && !std::same_as<T, bool>) {
+            update_bytes(reinterpret_cast<const char*>(x.data()),
+                         x.size() * sizeof(T));
+        } else {
+            for (const auto& y : x) {
+                update(y);
+            }
         }
     }
 
     // string
     auto update(const std::string& x) {
         update(x.size());
-        // TODO: should handle as 8-byte chunks
-        for (const auto& y : x) {
-            update(y);
-        }
+        update_bytes(x.data(), x.size());
     }
 
     // set
@@ -93,7 +119,14 @@ struct Hasher {
         }
     }
 
-    const u64 MULTIPLE = 6364136223846793005;
+    static constexpr u64 MULTIPLE = 6364136223846793005;
+
+  private:
+    static u64 load64(const char* p) {
+        u64 x;
+        std::memcpy(&x, p, 8);
+        return x;
+    }
 };
 
 }  // namespace internal
@@ -109,6 +142,27 @@ struct Hasher {
         h.update(x);
         return h.digest();
     }
+
+    // out[i] = (*this)(keys[i])
+    template <class T>
+    void hash_batch(std::span<const T> keys, std::span<u64> out) const {
+        assert(keys.size() == out.size());
+        size_t i = 0;
+        if constexpr (std::integral<T> && sizeof(T) <= 8) {
+            // interleave 4 chains to fill the multiplier pipeline
+            for (; i + 4 <= keys.size(); i += 4) {
+                u64 x[4];
+                for (int j = 0; j < 4; j++) {
+                    x[j] = internal::wymix(a ^ u64(keys[i + j]),
+                                           internal::Hasher::MULTIPLE);
+                }
+                for (int j = 0; j < 4; j++) {
+                    out[i + j] = internal::wymix(x[j], b);
+                }
+            }
+        }
+        for (; i < keys.size(); i++) out[i] = (*this)(keys[i]);
+    }
 };
 
 }  // namespace yosupo
@@ -1,10 +1,17 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
 #include <cassert>
+#include <optional>
+#include <span>
+#include <tuple>
 #include <utility>
 #include <vector>
 
+#include "yosupo/algebra.hpp"
+#include "yosupo/container/segtree.hpp"
+#include "yosupo/container/sparsetable.hpp"
 #include "yosupo/flattenvector.hpp"
 #include "yosupo/tree.hpp"
 
@@ -15,7 +22,9 @@ struct HLEulerTour {
     int n, root;
     std::vector<int> ord, rord;
 
-    explicit HLEulerTour(const RootedTree& tree) : n(tree.n), root(tree.root) {
+    // use_rmq: O(n) extra memory, O(1) lca
+    explicit HLEulerTour(const RootedTree& tree, bool use_rmq = false)
+        : n(tree.n), root(tree.root) {
         auto max_ch = std::vector<int>(n, -1);
         std::vector<int> size(n, 1);
         for (int i = n - 1; i >= 1; i--) {
@@ -61,11 +70,19 @@ struct HLEulerTour {
                 stack.push_back(max_ch[u]);
             }
         }
+
+        if (use_rmq) {
+            // for ordinals a < b, the lca is the minimum of ord[par] in (a, b]
+            std::vector<int> par_ord(n, -1);
+            for (int i = 1; i < n; i++) par_ord[i] = ord[tree.par[rord[i]]];
+            rmq.emplace(std::move(par_ord));
+        }
     }
 
     int _lca(int a, int b) const {
         if (a > b) std::swap(a, b);
         if (b < a + _size[a]) return a;
+        if (rmq) return rmq->query(a + 1, b + 1);
         while (a < b) {
             b = (nxt[b] >> 1);
         }
@@ -73,11 +90,149 @@ struct HLEulerTour {
     }
     int lca(int u, int v) const { return rord[_lca(ord[u], ord[v])]; }
 
+    // W queries at a time, advanced in turn so that their cache misses overlap
+    std::vector<int> lca_batch(std::span<const std::pair<int, int>> qs) const {
+        std::vector<int> res(qs.size());
+        if (rmq) {
+            for (size_t i = 0; i < qs.size(); i++) {
+                res[i] = lca(qs[i].first, qs[i].second);
+            }
+            return res;
+        }
+        static constexpr int W = 256;
+        std::array<int, W> a, b, act;
+        for (size_t s = 0; s < qs.size(); s += W) {
+            int m = int(std::min<size_t>(W, qs.size() - s));
+            for (int j = 0; j < m; j++) {
+                std::tie(a[j], b[j]) =
+                    std::minmax(ord[qs[s + j].first], ord[qs[s + j].second]);
+            }
+            int cnt = 0;
+            for (int j = 0; j < m; j++) {
+                if (b[j] < a[j] + _size[a[j]]) {
+                    b[j] = a[j];
+                } else {
+                    act[cnt++] = j;
+                }
+            }
+            // one step of each active query per round
+            while (cnt) {
+                int k = 0;
+                for (int i = 0; i < cnt; i++) {
+                    int j = act[i];
+                    b[j] = nxt[b[j]] >> 1;
+                    if (a[j] < b[j]) act[k++] = j;
+                }
+                cnt = k;
+            }
+            for (int j = 0; j < m; j++) res[s + j] = rord[b[j]];
+        }
+        return res;
+    }
+
     int subtree_size(int u) const { return _size[ord[u]]; }
+    // the subtree of u is [l, r) in ord
+    std::pair<int, int> subtree_range(int u) const {
+        return {ord[u], ord[u] + _size[ord[u]]};
+    }
+
+    struct PathRange {
+        int l, r;
+        // true: visited from r - 1 down to l (toward the root)
+        bool rev;
+    };
+    // call f(l, r, rev) for each range of the path u -> v (both inclusive) in
+    // this order, there are O(log n) ranges and each is a part of a heavy path
+    template <class F> void path_ranges(int u, int v, F f) const {
+        int a = ord[u], b = ord[v];
+        // ranges of the v side, in reverse order
+        std::array<std::pair<int, int>, 32> down;
+        int cnt = 0;
+        while (head(a) != head(b)) {
+            if (head(a) > head(b)) {
+                f(head(a), a + 1, true);
+                a = nxt[head(a)] >> 1;
+            } else {
+                down[cnt++] = {head(b), b + 1};
+                b = nxt[head(b)] >> 1;
+            }
+        }
+        if (a >= b) {
+            f(b, a + 1, true);
+        } else {
+            f(a, b + 1, false);
+        }
+        while (cnt) {
+            cnt--;
+            f(down[cnt].first, down[cnt].second, false);
+        }
+    }
+    std::vector<PathRange> path_ranges(int u, int v) const {
+        std::vector<PathRange> ranges;
+        path_ranges(u, v, [&](int l, int r, bool rev) {
+            ranges.push_back({l, r, rev});
+        });
+        return ranges;
+    }
 
   private:
     // key / value are ordinal
+    // nxt[i]: (head of the heavy path) * 2 + 1, or (parent) * 2 if i is a head
     std::vector<int> nxt, _size;
+    std::optional<LinearSparseTable<Min<int>>> rmq;
+
+    int head(int i) const { return (nxt[i] & 1) ? (nxt[i] >> 1) : i; }
+};
+
+// point set / path product / subtree product on vertices
+template <monoid M> struct HLPathQuery {
+    using S = M::S;
+
+    const HLEulerTour hl;
+
+    HLPathQuery(const RootedTree& tree,
+                const std::vector<S>& v,
+                const M& _m = M())
+        : hl(tree),
+          m(_m),
+          seg(permute(v, false), m),
+          rseg(permute(v, true), m) {}
+
+    S get(int u) const { return seg.get(hl.ord[u]); }
+    void set(int u, S x) {
+        int i = hl.ord[u];
+        seg.set(i, x);
+        rseg.set(hl.n - 1 - i, x);
+    }
+
+    // product of the path u -> v (both inclusive), in this order
+    S prod(int u, int v) const {
+        S sm = m.e;
+        hl.path_ranges(u, v, [&](int l, int r, bool rev) {
+            sm = m.op(sm,
+                      rev ? rseg.prod(hl.n - r, hl.n - l) : seg.prod(l, r));
+        });
+        return sm;
+    }
+    // product of the subtree of u, in ord
+    S subtree_prod(int u) const {
+        auto [l, r] = hl.subtree_range(u);
+        return seg.prod(l, r);
+    }
+
+  private:
+    M m;
+    // rseg holds the values in reverse order of ord
+    SegTree<M> seg, rseg;
+
+    std::vector<S> permute(const std::vector<S>& v, bool rev) const {
+        assert(int(v.size()) == hl.n);
+        std::vector<S> w(hl.n, m.e);
+        for (int u = 0; u < hl.n; u++) {
+            w[rev ? hl.n - 1 - hl.ord[u] : hl.ord[u]] = v[u];
+        }
+        return w;
+    }
 };
 
 }  // namespace yosupo
@@ -2,56 +2,68 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <bit>
+#include <cassert>
 #include <cmath>
+#include <optional>
+#include <span>
+#include <vector>
 
 #include "yosupo/types.hpp"
 
 namespace yosupo {
 
+template <int B> struct ConcurrentHyperLogLog;
+
 template <int B, int PLUS = 0> struct HyperLogLog {
     static_assert(4 <= B && B <= 30);
+    static_assert(PLUS >= 0);
 
     HyperLogLog() {}
 
     // insert random hash
     void add(u32 hash) {
-        if (count != -1) {
-            int idx = int(
-                std::lower_bound(hashes.begin(), hashes.begin() + count, hash) -
-                hashes.begin());
-            if (idx != count && hashes[idx] == hash) return;
-            if (count == PLUS) {
-                count = -1;
-                for (int i = 0; i < PLUS; i++) {
-                    add_dense(hashes[i]);
-                }
-                add_dense(hash);
-            } else {
-                count++;
-                std::copy_backward(hashes.begin() + idx,
-                                   hashes.begin() + count - 1,
-                                   hashes.begin() + count);
-                hashes[idx] = hash;
-            }
+        if (count == -1) {
+            add_dense(hash);
+            return;
+        }
+        // small set: open addressing, 0 is stored in has_zero
+        u32* slot = nullptr;
+        if (hash == 0) {
+            if (has_zero) return;
         } else {
+            u32 i = hash & (CAP - 1);
+            while (table[i] && table[i] != hash) i = (i + 1) & (CAP - 1);
+            if (table[i] == hash) return;
+            slot = &table[i];
+        }
+        if (count == PLUS) {
+            densify();
             add_dense(hash);
+            return;
+        }
+        count++;
+        if (slot) {
+            *slot = hash;
+        } else {
+            has_zero = true;
         }
     }
 
     int estimate() const {
         if (count != -1) return count;
 
+        // regs[i] <= 33
+        std::array<int, 34> hist = {};
+        for (u8 reg : regs) hist[reg]++;
         double est = 0.0;
-
-        for (int reg : regs) {
-            est += 1.0 / (double)(1LL << reg);
-        }
+        for (int v = 0; v < 34; v++) est += std::ldexp(hist[v], -v);
         est = 1.0 / est;
         est *= ALPHA * M * M;
 
         if (est <= 2.5 * M) {
-            int zeros = int(std::ranges::count(regs, 0));
+            int zeros = hist[0];
             if (zeros != 0) {
                 est = M * std::log(double(M) / (double)zeros);
             }
@@ -59,27 +71,91 @@ template <int B, int PLUS = 0> struct HyperLogLog {
         return int(round(est));
     }
 
+    // this = this ∪ rhs
+    void merge(const HyperLogLog& rhs) {
+        if (rhs.count != -1) {
+            rhs.for_each_sparse([&](u32 hash) { add(hash); });
+            return;
+        }
+        if (count != -1) densify();
+        // register-wise max, vectorized by the compiler
+        for (int i = 0; i < M; i++) regs[i] = std::max(regs[i], rhs.regs[i]);
+    }
+
     friend HyperLogLog operator+(const HyperLogLog& lhs,
                                  const HyperLogLog& rhs) {
-        if (rhs.count != -1) {
-            auto res = HyperLogLog(lhs);
-            res.add_sparse(rhs);
+        auto res = HyperLogLog(lhs);
+        res.merge(rhs);
+        return res;
+    }
+
+    // header: type (u8), B (u8), PLUS (u32)
+    // small set (type 0): count (u32), hashes (u32)
+    // otherwise (type 1): registers packed in 6 bits
+    // all integers are little endian
+    std::vector<u8> serialize() const {
+        std::vector<u8> res;
+        auto push32 = [&](u32 x) {
+            for (int i = 0; i < 4; i++) res.push_back(u8(x >> (8 * i)));
+        };
+        res.push_back(count == -1 ? 1 : 0);
+        res.push_back(u8(B));
+        push32(PLUS);
+        if (count != -1) {
+            push32(count);
+            for_each_sparse(push32);
             return res;
         }
-        if (lhs.count != -1) {
-            auto res = HyperLogLog(rhs);
-            res.add_sparse(lhs);
-            return res;
+        res.resize(HEADER + (M * 6 + 7) / 8);
+        for (int i = 0; i < M; i++) {
+            for (int j = 0; j < 6; j++) {
+                int pos = 6 * i + j;
+                res[HEADER + pos / 8] |= u8((regs[i] >> j & 1) << (pos % 8));
+            }
+        }
+        return res;
+    }
+
+    // std::nullopt if data is truncated, corrupted, or written with other B
+    // or PLUS
+    static std::optional<HyperLogLog> deserialize(std::span<const u8> data) {
+        auto get32 = [&](size_t pos) {
+            u32 x = 0;
+            for (int i = 0; i < 4; i++) x |= u32(data[pos + i]) << (8 * i);
+            return x;
+        };
+        if (data.size() < HEADER || data[1] != B || get32(2) != PLUS) {
+            return std::nullopt;
         }
         HyperLogLog res;
+        if (data[0] == 0) {
+            if (data.size() < HEADER + 4) return std::nullopt;
+            u32 n = get32(HEADER);
+            if (n > PLUS || data.size() != HEADER + 4 + 4 * size_t(n)) {
+                return std::nullopt;
+            }
+            for (u32 i = 0; i < n; i++) res.add(get32(HEADER + 4 + 4 * i));
+            return res;
+        }
+        if (data[0] != 1 || data.size() != HEADER + (M * 6 + 7) / 8) {
+            return std::nullopt;
+        }
         res.count = -1;
         for (int i = 0; i < M; i++) {
-            res.regs[i] = std::max(lhs.regs[i], rhs.regs[i]);
+            for (int j = 0; j < 6; j++) {
+                int pos = 6 * i + j;
+                res.regs[i] |=
+                    u8((data[HEADER + pos / 8] >> (pos % 8) & 1) << j);
+            }
+            // add_dense never makes a register larger than 33
+            if (res.regs[i] > 33) return std::nullopt;
         }
         return res;
     }
 
   private:
+    template <int> friend struct ConcurrentHyperLogLog;
+
     static constexpr int M = 1 << B;
     static constexpr double ALPHA = []() {
         switch (B) {
@@ -93,21 +169,65 @@ template <int B, int PLUS = 0> struct HyperLogLog {
                 return 0.7213 / (1 + 1.079 / M);
         }
     }();
+    static constexpr int CAP = PLUS ? int(std::bit_ceil(u32(2 * PLUS))) : 1;
+    static constexpr size_t HEADER = 6;
 
+    // count == -1: dense (regs), otherwise small set (table, has_zero)
     int count = 0;
     std::array<u8, M> regs = {};
-    std::array<u32, PLUS> hashes = {};
+    std::array<u32, CAP> table = {};
+    bool has_zero = false;
 
     void add_dense(u32 hash) {
         u32 index = hash >> (32 - B);
         regs[index] = std::max(regs[index], (u8)(std::countr_zero(hash) + 1));
     }
 
-    void add_sparse(const HyperLogLog& rhs) {
-        for (int i = 0; i < rhs.count; i++) {
-            add(rhs.hashes[i]);
+    template <class F> void for_each_sparse(F f) const {
+        if (has_zero) f(0);
+        for (u32 hash : table) {
+            if (hash) f(hash);
         }
     }
+
+    void densify() {
+        for_each_sparse([&](u32 hash) { add_dense(hash); });
+        count = -1;
+        table = {};
+        has_zero = false;
+    }
+};
+
+// HyperLogLog whose add can be called from multiple threads
+template <int B> struct ConcurrentHyperLogLog {
+    static_assert(4 <= B && B <= 30);
+
+    ConcurrentHyperLogLog() {}
+
+    // insert random hash, thread-safe
+    void add(u32 hash) {
+        auto& reg = regs[hash >> (32 - B)];
+        u8 v = u8(std::countr_zero(hash) + 1);
+        u8 cur = reg.load(std::memory_order_relaxed);
+        while (cur < v &&
+               !reg.compare_exchange_weak(cur, v, std::memory_order_relaxed)) {
+        }
+    }
+
+    // registers may be read while other threads are adding
+    HyperLogLog<B> snapshot() const {
+        HyperLogLog<B> res;
+        res.count = -1;
+        for (int i = 0; i < (1 << B); i++) {
+            res.regs[i] = regs[i].load(std::memory_order_relaxed);
+        }
+        return res;
+    }
+
+    int estimate() const { return snapshot().estimate(); }
+
+  private:
+    std::array<std::atomic<u8>, 1 << B> regs;
 };
 
-}  // namespace yosupo
\ No newline at end of file
+}  // namespace yosupo
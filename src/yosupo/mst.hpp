@@ -1,44 +1,155 @@
 #pragma once
 
 #include <algorithm>
+#include <limits>
 #include <ranges>
+#include <thread>
+#include <tuple>
 #include <utility>
 #include <vector>
 
 #include "atcoder/dsu.hpp"
+#include "yosupo/types.hpp"
 #include "yosupo/util.hpp"
 
 namespace yosupo {
 
+// Edges are ordered by (cost, index), so all methods return the same forest
+// ids are in this order
 template <class C> struct MST {
     MST(int _n) { n = _n; }
-    void add_edge(int u, int v, C c) { edges.push_back({u, v, c}); }
+    void add_edge(int u, int v, C c) {
+        us.push_back(u);
+        vs.push_back(v);
+        cs.push_back(c);
+    }
 
+    // Kruskal
     std::pair<C, std::vector<int>> mst() {
-        int m = int(size(edges));
+        int m = int(cs.size());
         std::vector<int> idx = yosupo::to_vec(std::views::iota(0, m));
-        std::ranges::sort(
-            idx, [&](int l, int r) { return edges[l].c < edges[r].c; });
+        std::ranges::sort(idx, less());
         atcoder::dsu uf(n);
-        C sum = C(0);
         std::vector<int> ids;
         for (int i : idx) {
-            auto e = edges[i];
-            if (uf.same(e.u, e.v)) continue;
-            uf.merge(e.u, e.v);
+            if (uf.same(us[i], vs[i])) continue;
+            uf.merge(us[i], vs[i]);
             ids.push_back(i);
-            sum += e.c;
         }
-        return {sum, ids};
+        return result(std::move(ids));
+    }
+
+    // Filter-Kruskal: split the edges at the median, solve the lighter half
+    // and drop the edges of the heavier half which are already in a component
+    std::pair<C, std::vector<int>> mst_filter_kruskal() {
+        int m = int(cs.size());
+        std::vector<int> idx = yosupo::to_vec(std::views::iota(0, m));
+        atcoder::dsu uf(n);
+        std::vector<int> ids;
+        // [l, r), whether it needs filtering
+        std::vector<std::tuple<int, int, bool>> st = {{0, m, false}};
+        while (!st.empty() && int(ids.size()) < n - 1) {
+            auto [l, r, filter] = st.back();
+            st.pop_back();
+            if (filter) {
+                auto it = std::remove_if(
+                    idx.begin() + l, idx.begin() + r,
+                    [&](int i) { return uf.same(us[i], vs[i]); });
+                r = int(it - idx.begin());
+            }
+            if (r - l <= THRESHOLD) {
+                std::sort(idx.begin() + l, idx.begin() + r, less());
+                for (int j = l; j < r; j++) {
+                    int i = idx[j];
+                    if (uf.same(us[i], vs[i])) continue;
+                    uf.merge(us[i], vs[i]);
+                    ids.push_back(i);
+                }
+                continue;
+            }
+            int mid = (l + r) / 2;
+            std::nth_element(idx.begin() + l, idx.begin() + mid,
+                             idx.begin() + r, less());
+            st.push_back({mid, r, true});
+            st.push_back({l, mid, false});
+        }
+        return result(std::move(ids));
+    }
+
+    // Boruvka, the scan for the lightest edge of each component is split
+    // among threads
+    std::pair<C, std::vector<int>> mst_boruvka(int threads = 1) {
+        int m = int(cs.size());
+        atcoder::dsu uf(n);
+        std::vector<int> ids;
+        // edges of each thread which may still join two components
+        std::vector<std::vector<int>> alive(threads);
+        for (int t = 0; t < threads; t++) {
+            for (int i = int(i64(m) * t / threads);
+                 i < int(i64(m) * (t + 1) / threads); i++) {
+                alive[t].push_back(i);
+            }
+        }
+        std::vector<int> comp(n);
+        // best[t][c]: the lightest edge from the component c, or -1
+        std::vector<std::vector<int>> best(threads, std::vector<int>(n, -1));
+        auto scan = [&](int t) {
+            auto& b = best[t];
+            std::ranges::fill(b, -1);
+            std::erase_if(alive[t],
+                          [&](int i) { return comp[us[i]] == comp[vs[i]]; });
+            for (int i : alive[t]) {
+                for (int c : {comp[us[i]], comp[vs[i]]}) {
+                    if (b[c] == -1 || less()(i, b[c])) b[c] = i;
+                }
+            }
+        };
+        while (true) {
+            for (int u = 0; u < n; u++) comp[u] = uf.leader(u);
+            if (threads == 1) {
+                scan(0);
+            } else {
+                std::vector<std::thread> ths;
+                for (int t = 0; t < threads; t++) ths.emplace_back(scan, t);
+                for (auto& th : ths) th.join();
+            }
+            bool updated = false;
+            for (int c = 0; c < n; c++) {
+                if (comp[c] != c) continue;
+                int e = -1;
+                for (int t = 0; t < threads; t++) {
+                    int i = best[t][c];
+                    if (i != -1 && (e == -1 || less()(i, e))) e = i;
+                }
+                if (e == -1 || uf.same(us[e], vs[e])) continue;
+                uf.merge(us[e], vs[e]);
+                ids.push_back(e);
+                updated = true;
+            }
+            if (!updated) break;
+        }
+        std::ranges::sort(ids, less());
+        return result(std::move(ids));
     }
 
   private:
+    static constexpr int THRESHOLD = 1024;
+
     int n;
-    struct E {
-        int u, v;
-        C c;
-    };
-    std::vector<E> edges;
+    // struct of arrays
+    std::vector<int> us, vs;
+    std::vector<C> cs;
+
+    auto less() const {
+        return [&](int l, int r) {
+            return cs[l] < cs[r] || (!(cs[r] < cs[l]) && l < r);
+        };
+    }
+    std::pair<C, std::vector<int>> result(std::vector<int> ids) const {
+        C sum = C(0);
+        for (int i : ids) sum += cs[i];
+        return {sum, ids};
+    }
 };
 
-}  // namespace yosupo
\ No newline at end of file
+}  // namespace yosupo
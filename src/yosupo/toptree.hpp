@@ -1,10 +1,14 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <bit>
 #include <bitset>
 #include <cassert>
 #include <ranges>
+#include <span>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -133,6 +137,7 @@ template <static_top_tree_dp TreeDP> struct StaticTopTree {
             }
         }
         points[n] = dp.add_edge(build_compress(tree.root));
+        relabel(tree, heavy_child);
     }
 
     Vertex get_vertex(int u) { return vertices[u]; }
@@ -172,6 +177,44 @@ template <static_top_tree_dp TreeDP> struct StaticTopTree {
         }
     }
 
+    // recompute each affected node once
+    // mark: count the dirty children of every affected node
+    // up: recompute a node when its last dirty child is done
+    // updates are split among threads, the thread which finishes the last
+    // dirty child of a node continues, dp must be thread-safe if threads > 1
+    void update_batch(std::span<const std::pair<int, Vertex>> updates,
+                      int threads = 1) {
+        assert(threads >= 1);
+        vertex_cnt.resize(n);
+        compressed_cnt.resize(compressed.size());
+        raked_cnt.resize(raked.size());
+        if (threads == 1) {
+            mark_batch<false>(updates, 0, updates.size());
+            up_batch<false>(updates, 0, updates.size());
+            return;
+        }
+        // the last update of a vertex wins
+        for (const auto& [u, vertex] : updates) vertices[u] = vertex;
+        auto run = [&](auto f) {
+            std::vector<std::thread> workers;
+            for (int t = 1; t < threads; t++) workers.emplace_back(f, t);
+            f(0);
+            for (auto& w : workers) w.join();
+        };
+        auto range = [&](int t) {
+            return std::pair{updates.size() * t / threads,
+                             updates.size() * (t + 1) / threads};
+        };
+        run([&](int t) {
+            auto [l, r] = range(t);
+            mark_batch<true>(updates, l, r);
+        });
+        run([&](int t) {
+            auto [l, r] = range(t);
+            up_batch<true>(updates, l, r);
+        });
+    }
+
     Point all_prod() { return points[n]; }
 
     Path path_prod(int u) {
@@ -243,6 +286,192 @@ template <static_top_tree_dp TreeDP> struct StaticTopTree {
         }
     }
 
+    // counters of update_batch, shared among threads if ATOMIC
+    std::vector<u8> vertex_cnt, compressed_cnt, raked_cnt;
+
+    // old value
+    template <bool ATOMIC> static u8 inc(u8& cnt) {
+        if constexpr (ATOMIC) {
+            return std::atomic_ref(cnt).fetch_add(1, std::memory_order_relaxed);
+        } else {
+            return cnt++;
+        }
+    }
+    // new value, the thread which gets 0 sees the writes of the other threads
+    // to the node
+    template <bool ATOMIC> static u8 dec(u8& cnt) {
+        if constexpr (ATOMIC) {
+            std::atomic_ref c(cnt);
+            return u8(c.fetch_sub(1, std::memory_order_acq_rel) - 1);
+        } else {
+            return --cnt;
+        }
+    }
+
+    // climb the compress / rake tree from the slot id, return whether the
+    // root is reached
+    template <bool ATOMIC, class D>
+    static bool mark_inner(int id,
+                           std::vector<Inner<D>>& nodes,
+                           std::vector<u8>& cnt) {
+        while (true) {
+            id /= 2;
+            if (inc<ATOMIC>(cnt[id])) return false;
+            id = nodes[id].par;
+            if (id < 0) return true;
+        }
+    }
+    // same as mark_inner, with the root's value
+    template <bool ATOMIC, class D, class M>
+    static std::pair<bool, D> up_inner(int id,
+                                       std::vector<Inner<D>>& nodes,
+                                       std::vector<u8>& cnt,
+                                       M& monoid,
+                                       D p) {
+        while (id >= 0) {
+            if (id % 2 == 0) {
+                nodes[id / 2].d.first = p;
+            } else {
+                nodes[id / 2].d.second = p;
+            }
+            id /= 2;
+            if (dec<ATOMIC>(cnt[id])) return {false, p};
+            p = monoid.op(nodes[id].d.first, nodes[id].d.second);
+            id = nodes[id].par;
+        }
+        return {true, p};
+    }
+
+    // updates[l..r), vertices are already updated if ATOMIC
+    template <bool ATOMIC>
+    void mark_batch(std::span<const std::pair<int, Vertex>> updates,
+                    size_t l,
+                    size_t r) {
+        for (size_t i = l; i < r; i++) {
+            int u = updates[i].first;
+            if constexpr (!ATOMIC) vertices[u] = updates[i].second;
+            while (u != n && !inc<ATOMIC>(vertex_cnt[u])) {
+                auto [h_par, c_id, r_id] = node_ids[u];
+                if (c_id >= 0 &&
+                    !mark_inner<ATOMIC>(c_id, compressed, compressed_cnt)) {
+                    break;
+                }
+                if (r_id >= 0 && !mark_inner<ATOMIC>(r_id, raked, raked_cnt)) {
+                    break;
+                }
+                u = h_par;
+            }
+        }
+    }
+    template <bool ATOMIC>
+    void up_batch(std::span<const std::pair<int, Vertex>> updates,
+                  size_t l,
+                  size_t r) {
+        for (size_t i = l; i < r; i++) {
+            int u = updates[i].first;
+            while (u != n && !dec<ATOMIC>(vertex_cnt[u])) {
+                auto [h_par, c_id, r_id] = node_ids[u];
+                auto [c_top, path] = up_inner<ATOMIC>(
+                    c_id, compressed, compressed_cnt, dp.path,
+                    dp.add_vertex(points[u], vertices[u]));
+                if (!c_top) break;
+                auto [r_top, point] = up_inner<ATOMIC>(
+                    r_id, raked, raked_cnt, dp.point, dp.add_edge(path));
+                if (!r_top) break;
+                points[h_par] = point;
+                u = h_par;
+            }
+        }
+    }
+
+    // renumber compress / rake nodes so that each compress / rake tree is
+    // contiguous in preorder, and heavy paths near the root come first
+    void relabel(const RootedTree& tree, const std::vector<int>& heavy_child) {
+        // child of each slot: node id, or ~u for a leaf (vertex / path of u)
+        std::vector<std::array<int, 2>> c_ch(compressed.size()),
+            r_ch(raked.size());
+        for (int i = 0; i < int(compressed.size()); i++) {
+            int par = compressed[i].par;
+            if (par >= 0) c_ch[par / 2][par % 2] = i;
+        }
+        for (int i = 0; i < int(raked.size()); i++) {
+            int par = raked[i].par;
+            if (par >= 0) r_ch[par / 2][par % 2] = i;
+        }
+        for (int u = 0; u < n; u++) {
+            auto [h_par, c_id, r_id] = node_ids[u];
+            if (c_id >= 0) c_ch[c_id / 2][c_id % 2] = ~u;
+            if (r_id >= 0) r_ch[r_id / 2][r_id % 2] = ~u;
+        }
+        auto root = [&](int id, const auto& nodes) {
+            id /= 2;
+            while (nodes[id].par >= 0) id = nodes[id].par / 2;
+            return id;
+        };
+
+        std::vector<int> c_ord(compressed.size()), r_ord(raked.size());
+        int c_cnt = 0, r_cnt = 0;
+        // preorder of the compress / rake tree rooted at id, the leaves
+        // (vertices / heads of light paths) are pushed to que
+        std::vector<int> st;
+        auto visit = [&](int id, bool rake, std::vector<int>& que) {
+            st = {id};
+            while (!st.empty()) {
+                int x = st.back();
+                st.pop_back();
+                (rake ? r_ord : c_ord)[x] = (rake ? r_cnt : c_cnt)++;
+                for (int c : (rake ? r_ch : c_ch)[x] | std::views::reverse) {
+                    if (c >= 0) {
+                        st.push_back(c);
+                    } else {
+                        que.push_back(~c);
+                    }
+                }
+            }
+        };
+        // heavy paths in bfs order, each path is followed by the rake trees
+        // of its vertices
+        std::vector<int> paths = {tree.root}, us;
+        for (int i = 0; i < int(paths.size()); i++) {
+            int c_id = node_ids[paths[i]].c_id;
+            us.clear();
+            if (c_id < 0) {
+                us.push_back(paths[i]);
+            } else {
+                visit(root(c_id, compressed), false, us);
+            }
+            for (int u : us) {
+                for (int v : tree.children.at(u)) {
+                    if (v == heavy_child[u]) continue;
+                    int r_id = node_ids[v].r_id;
+                    if (r_id < 0) {
+                        paths.push_back(v);
+                    } else {
+                        visit(root(r_id, raked), true, paths);
+                    }
+                    break;
+                }
+            }
+        }
+
+        assert(c_cnt == int(compressed.size()) && r_cnt == int(raked.size()));
+
+        auto apply = [&](auto& nodes, const std::vector<int>& ord) {
+            auto old = nodes;
+            for (int i = 0; i < int(old.size()); i++) {
+                int par = old[i].par;
+                if (par >= 0) par = 2 * ord[par / 2] + par % 2;
+                nodes[ord[i]] = {old[i].d, par};
+            }
+        };
+        apply(compressed, c_ord);
+        apply(raked, r_ord);
+        for (auto& [h_par, c_id, r_id] : node_ids) {
+            if (c_id >= 0) c_id = 2 * c_ord[c_id / 2] + c_id % 2;
+            if (r_id >= 0) r_id = 2 * r_ord[r_id / 2] + r_id % 2;
+        }
+    }
+
     std::vector<Point> points;
     struct ID {
         int h_par, c_id, r_id;
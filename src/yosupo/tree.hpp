@@ -1,54 +1,116 @@
 #pragma once
 
+#include <algorithm>
 #include <cassert>
 #include <utility>
 #include <vector>
 
 #include "yosupo/flattenvector.hpp"
+#include "yosupo/types.hpp"
 
 namespace yosupo {
 
+// topo: parents come before their children
 struct RootedTree {
     int n, root;
     FlattenVector<int> children;
     std::vector<int> topo, par;
 };
 
+namespace internal {
+
+// counting sort by parent, children are in increasing order
+// vertices are split among threads, each thread has its own n counters
+inline FlattenVector<int> children_from_par(const std::vector<int>& par,
+                                            int threads = 1) {
+    assert(threads >= 1);
+    int n = int(par.size());
+    if (threads == 1) {
+        std::vector<int> start(n + 1), ch(std::max(n - 1, 0));
+        for (int u = 0; u < n; u++) {
+            if (par[u] != -1) start[par[u]]++;
+        }
+        for (int i = 0; i < n; i++) start[i + 1] += start[i];
+        for (int u = n - 1; u >= 0; u--) {
+            if (par[u] != -1) ch[--start[par[u]]] = u;
+        }
+        return FlattenVector<int>(std::move(start), std::move(ch));
+    }
+    return FlattenVector<int>(
+        n,
+        [&](int t, auto f) {
+            for (int u = int(i64(n) * t / threads);
+                 u < int(i64(n) * (t + 1) / threads); u++) {
+                if (par[u] != -1) f(par[u], u);
+            }
+        },
+        threads);
+}
+
+}  // namespace internal
+
+// par[root] = -1, topo is in bfs order
+// children are built with threads, the bfs is sequential
+inline RootedTree rooted_tree_from_par(std::vector<int> par, int threads = 1) {
+    int n = int(par.size());
+    int root = int(std::find(par.begin(), par.end(), -1) - par.begin());
+    assert(root < n);
+    auto children = internal::children_from_par(par, threads);
+
+    auto topo = std::vector<int>();
+    topo.reserve(n);
+    topo.push_back(root);
+    for (int i = 0; i < int(topo.size()); i++) {
+        for (int v : children.at(topo[i])) topo.push_back(v);
+    }
+    assert(int(topo.size()) == n);
+    return {n, root, std::move(children), std::move(topo), std::move(par)};
+}
+
+// O(n) memory, edges are not stored
 struct RootedTreeBuilder {
-    RootedTreeBuilder(int _n) : n(_n) { edges.reserve(2 * (n - 1)); }
+    RootedTreeBuilder(int _n) : n(_n), nodes(n) {}
 
     void add_edge(int u, int v) {
-        edges.push_back({u, v});
-        edges.push_back({v, u});
+        nodes[u].deg++;
+        nodes[u].nbr ^= v;
+        nodes[v].deg++;
+        nodes[v].nbr ^= u;
     }
 
-    RootedTree build(int root) && {
-        assert(int(edges.size()) == 2 * (n - 1));
-
-        auto g = FlattenVector(n, edges);
+    // children are built with threads, peeling is sequential
+    RootedTree build(int root, int threads = 1) && {
+        // peel leaves, nbr is the xor of the remaining neighbors
+        // the reverse of the peeling order is a topological order
         auto par = std::vector<int>(n, -1);
-        auto topo = std::vector<int>();
-        topo.reserve(n);
-        topo.push_back(root);
+        auto topo = std::vector<int>(n);
+        int cnt = n;
         for (int i = 0; i < n; i++) {
-            int u = topo[i];
-            for (int v : g.at(u)) {
-                if (v == par[u]) continue;
-                par[v] = u;
-                topo.push_back(v);
+            int u = i;
+            while (u <= i && u != root && nodes[u].deg == 1) {
+                int p = nodes[u].nbr;
+                par[u] = p;
+                topo[--cnt] = u;
+                nodes[u].deg = 0;
+                nodes[p].deg--;
+                nodes[p].nbr ^= u;
+                u = p;
             }
         }
-        assert(int(topo.size()) == n);
-
-        g.erase_if([&](const std::pair<int, int>& edge) {
-            return par[edge.second] != edge.first;
-        });
-        return {n, root, std::move(g), std::move(topo), std::move(par)};
+        assert(cnt == 1);
+        topo[0] = root;
+        std::vector<Node>().swap(nodes);
+        auto children = internal::children_from_par(par, threads);
+        return {n, root, std::move(children), std::move(topo), std::move(par)};
     }
 
   private:
     int n;
-    std::vector<std::pair<int, int>> edges;
+    struct Node {
+        // degree / xor of the neighbors
+        int deg = 0, nbr = 0;
+    };
+    std::vector<Node> nodes;
 };
 
 }  // namespace yosupo
@@ -0,0 +1,129 @@
+#include <functional>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "yosupo/container/binaryheap.hpp"
+#include "yosupo/container/pairingheap.hpp"
+#include "yosupo/container/radixheap.hpp"
+#include "yosupo/random.hpp"
+#include "yosupo/types.hpp"
+
+using yosupo::u64;
+using P = std::pair<u64, int>;
+
+struct Graph {
+    int n;
+    std::vector<std::vector<std::pair<int, u64>>> g;
+};
+
+static const Graph& graph(int n) {
+    static Graph gr = {0, {}};
+    if (gr.n != n) {
+        yosupo::Random gen(1);
+        gr = {n, std::vector<std::vector<std::pair<int, u64>>>(n)};
+        for (int i = 0; i < 8 * n; i++) {
+            int u = yosupo::uniform(0, n - 1, gen);
+            int v = yosupo::uniform(0, n - 1, gen);
+            gr.g[u].push_back({v, yosupo::uniform(u64(1), u64(1000000), gen)});
+        }
+    }
+    return gr;
+}
+
+template <class F> static void dijkstra_bench(benchmark::State& state, F f) {
+    const auto& gr = graph(int(state.range(0)));
+    for (auto _ : state) {
+        auto dist = f(gr);
+        benchmark::DoNotOptimize(dist.data());
+    }
+}
+
+static void BM_DijkstraPriorityQueue(benchmark::State& state) {
+    dijkstra_bench(state, [](const Graph& gr) {
+        std::vector<u64> dist(gr.n, -1);
+        std::priority_queue<P, std::vector<P>, std::greater<P>> pq;
+        dist[0] = 0;
+        pq.push({0, 0});
+        while (!pq.empty()) {
+            auto [d, u] = pq.top();
+            pq.pop();
+            if (dist[u] < d) continue;
+            for (auto [v, w] : gr.g[u]) {
+                if (d + w < dist[v]) {
+                    dist[v] = d + w;
+                    pq.push({dist[v], v});
+                }
+            }
+        }
+        return dist;
+    });
+}
+BENCHMARK(BM_DijkstraPriorityQueue)->Arg(1 << 12)->Arg(1 << 18);
+
+template <class Manager> static void BM_Dijkstra(benchmark::State& state) {
+    dijkstra_bench(state, [](const Graph& gr) {
+        Manager manager;
+        std::vector<u64> dist(gr.n, -1);
+        auto h = manager.build();
+        dist[0] = 0;
+        manager.push(h, {0, 0});
+        while (!h.empty()) {
+            auto [d, u] = manager.top(h);
+            manager.pop(h);
+            if (dist[u] < d) continue;
+            for (auto [v, w] : gr.g[u]) {
+                if (d + w < dist[v]) {
+                    dist[v] = d + w;
+                    manager.push(h, {dist[v], v});
+                }
+            }
+        }
+        return dist;
+    });
+}
+BENCHMARK(
+    BM_Dijkstra<yosupo::MeldableDaryHeapManager<P, std::greater<P>, 2>>)
+    ->Arg(1 << 12)
+    ->Arg(1 << 18);
+BENCHMARK(
+    BM_Dijkstra<yosupo::MeldableDaryHeapManager<P, std::greater<P>, 4>>)
+    ->Arg(1 << 12)
+    ->Arg(1 << 18);
+BENCHMARK(
+    BM_Dijkstra<yosupo::MeldableDaryHeapManager<P, std::greater<P>, 8>>)
+    ->Arg(1 << 12)
+    ->Arg(1 << 18);
+BENCHMARK(BM_Dijkstra<yosupo::RadixHeapManager<u64, int>>)
+    ->Arg(1 << 12)
+    ->Arg(1 << 18);
+
+static void BM_DijkstraPairingHeap(benchmark::State& state) {
+    dijkstra_bench(state, [](const Graph& gr) {
+        yosupo::PairingHeapManager<P, std::greater<P>> manager;
+        std::vector<u64> dist(gr.n, -1);
+        std::vector<int> id(gr.n, -1);
+        auto h = manager.build();
+        dist[0] = 0;
+        id[0] = manager.push(h, {0, 0});
+        while (!h.empty()) {
+            auto [d, u] = manager.top(h);
+            manager.pop(h);
+            for (auto [v, w] : gr.g[u]) {
+                if (d + w < dist[v]) {
+                    dist[v] = d + w;
+                    if (id[v] == -1) {
+                        id[v] = manager.push(h, {dist[v], v});
+                    } else {
+                        manager.decrease_key(h, id[v], {dist[v], v});
+                    }
+                }
+            }
+        }
+        return dist;
+    });
+}
+BENCHMARK(BM_DijkstraPairingHeap)->Arg(1 << 12)->Arg(1 << 18);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,62 @@
+#include <bitset>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "yosupo/container/bitvector.hpp"
+
+constexpr size_t N = 1 << 20;
+
+static std::vector<size_t> weights() {
+    std::vector<size_t> w;
+    for (size_t i = 0; i < 64; i++) w.push_back((i * 7919 + 13) % 4096 + 1);
+    return w;
+}
+
+static void BM_SubsetSumBitset(benchmark::State& state) {
+    auto w = weights();
+    for (auto _ : state) {
+        std::bitset<N> dp;
+        dp.set(0);
+        for (auto x : w) dp |= dp << x;
+        benchmark::DoNotOptimize(dp);
+    }
+}
+BENCHMARK(BM_SubsetSumBitset);
+
+static void BM_SubsetSumBitVecShift(benchmark::State& state) {
+    auto w = weights();
+    for (auto _ : state) {
+        yosupo::BitVec dp(N);
+        dp.set(0);
+        for (auto x : w) dp |= dp << x;
+        benchmark::DoNotOptimize(dp);
+    }
+}
+BENCHMARK(BM_SubsetSumBitVecShift);
+
+static void BM_SubsetSumBitVecOrShifted(benchmark::State& state) {
+    auto w = weights();
+    for (auto _ : state) {
+        yosupo::BitVec dp(N);
+        dp.set(0);
+        for (auto x : w) dp.or_shifted(dp, x);
+        benchmark::DoNotOptimize(dp);
+    }
+}
+BENCHMARK(BM_SubsetSumBitVecOrShifted);
+
+static void BM_CountBitset(benchmark::State& state) {
+    std::bitset<N> bs;
+    for (size_t i = 0; i < N; i += 3) bs.set(i);
+    for (auto _ : state) benchmark::DoNotOptimize(bs.count());
+}
+BENCHMARK(BM_CountBitset);
+
+static void BM_CountBitVec(benchmark::State& state) {
+    yosupo::BitVec bv(N);
+    for (size_t i = 0; i < N; i += 3) bv.set(i);
+    for (auto _ : state) benchmark::DoNotOptimize(bv.count_range(0, N));
+}
+BENCHMARK(BM_CountBitVec);
+
+BENCHMARK_MAIN();
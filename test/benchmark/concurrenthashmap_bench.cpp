@@ -0,0 +1,62 @@
+#include <functional>
+#include <mutex>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "yosupo/container/concurrenthashmap.hpp"
+#include "yosupo/container/hashmap.hpp"
+#include "yosupo/random.hpp"
+#include "yosupo/types.hpp"
+
+using yosupo::u64;
+
+constexpr int N = 1 << 16;
+
+static std::vector<u64> keys(u64 seed) {
+    yosupo::Random gen(seed);
+    std::vector<u64> v(N);
+    for (auto& x : v) x = yosupo::uniform(u64(0), u64(N) * 4, gen);
+    return v;
+}
+
+static void BM_UpsertGlobalMutex(benchmark::State& state) {
+    static std::mutex mtx;
+    static yosupo::IncrementalHashMap<u64, u64> mp;
+    auto v = keys(state.thread_index());
+    for (auto _ : state) {
+        for (auto x : v) {
+            std::lock_guard lock(mtx);
+            mp[x]++;
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * N);
+}
+BENCHMARK(BM_UpsertGlobalMutex)->ThreadRange(1, 32)->UseRealTime();
+
+static void BM_UpsertConcurrent(benchmark::State& state) {
+    static yosupo::ConcurrentHashMap<u64, u64> mp;
+    auto v = keys(state.thread_index());
+    for (auto _ : state) {
+        for (auto x : v) mp.upsert(x, 1, std::plus<u64>());
+    }
+    state.SetItemsProcessed(state.iterations() * N);
+}
+BENCHMARK(BM_UpsertConcurrent)->ThreadRange(1, 32)->UseRealTime();
+
+static void BM_GetConcurrent(benchmark::State& state) {
+    static yosupo::ConcurrentHashMap<u64, u64> mp = [] {
+        yosupo::ConcurrentHashMap<u64, u64> m;
+        for (auto x : keys(0)) m.insert_or_assign(x, x);
+        return m;
+    }();
+    auto v = keys(state.thread_index());
+    for (auto _ : state) {
+        u64 sum = 0;
+        for (auto x : v) sum += mp.contains(x);
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * N);
+}
+BENCHMARK(BM_GetConcurrent)->ThreadRange(1, 32)->UseRealTime();
+
+BENCHMARK_MAIN();
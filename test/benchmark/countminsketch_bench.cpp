@@ -0,0 +1,98 @@
+#include <cmath>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "yosupo/container/hashmap.hpp"
+#include "yosupo/countminsketch.hpp"
+#include "yosupo/random.hpp"
+#include "yosupo/types.hpp"
+
+using yosupo::u64;
+
+constexpr int N = 1 << 20;
+
+// zipf-like stream: key k appears with probability ~ 1 / k
+static const std::vector<u64>& stream() {
+    static std::vector<u64> v = [] {
+        yosupo::Random gen(1);
+        std::vector<u64> res(N);
+        for (auto& x : res) {
+            double r = yosupo::random_01(gen);
+            x = u64(std::exp(r * std::log(double(N))));
+        }
+        return res;
+    }();
+    return v;
+}
+
+static yosupo::IncrementalHashMap<u64, u64> exact_count() {
+    yosupo::IncrementalHashMap<u64, u64> mp;
+    for (auto x : stream()) mp[x]++;
+    return mp;
+}
+
+static void BM_ExactHashMap(benchmark::State& state) {
+    for (auto _ : state) {
+        auto mp = exact_count();
+        benchmark::DoNotOptimize(mp.size());
+    }
+    state.SetItemsProcessed(state.iterations() * N);
+}
+BENCHMARK(BM_ExactHashMap);
+
+template <bool CONSERVATIVE>
+static yosupo::CountMinSketch<u64> build_cms(int width_log) {
+    yosupo::CountMinSketch<u64> cms(width_log);
+    for (auto x : stream()) {
+        if (CONSERVATIVE) {
+            cms.add_conservative(x);
+        } else {
+            cms.add(x);
+        }
+    }
+    return cms;
+}
+
+template <bool CONSERVATIVE>
+static void BM_CountMinSketch(benchmark::State& state) {
+    int width_log = int(state.range(0));
+    for (auto _ : state) {
+        auto cms = build_cms<CONSERVATIVE>(width_log);
+        benchmark::DoNotOptimize(cms.estimate(0));
+    }
+    state.SetItemsProcessed(state.iterations() * N);
+
+    double err = 0;
+    auto cms = build_cms<CONSERVATIVE>(width_log);
+    auto mp = exact_count();
+    for (const auto& [k, c] : mp) err += double(cms.estimate(k) - c);
+    state.counters["avg_error"] = err / double(mp.size());
+}
+BENCHMARK(BM_CountMinSketch<false>)->Arg(12)->Arg(16);
+BENCHMARK(BM_CountMinSketch<true>)->Arg(12)->Arg(16);
+
+static yosupo::SpaceSaving<u64> build_ss(int capacity) {
+    yosupo::SpaceSaving<u64> ss(capacity);
+    for (auto x : stream()) ss.add(x);
+    return ss;
+}
+
+static void BM_SpaceSaving(benchmark::State& state) {
+    int capacity = int(state.range(0));
+    for (auto _ : state) {
+        auto ss = build_ss(capacity);
+        benchmark::DoNotOptimize(ss.estimate(0));
+    }
+    state.SetItemsProcessed(state.iterations() * N);
+
+    // error of the top-10 keys
+    double err = 0;
+    auto ss = build_ss(capacity);
+    auto mp = exact_count();
+    auto top = ss.top();
+    for (int i = 0; i < 10; i++) err += double(top[i].count - mp[top[i].key]);
+    state.counters["top10_avg_error"] = err / 10;
+}
+BENCHMARK(BM_SpaceSaving)->Arg(100)->Arg(1000);
+
+BENCHMARK_MAIN();
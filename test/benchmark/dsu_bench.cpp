@@ -0,0 +1,83 @@
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "atcoder/dsu"
+#include "benchmark/benchmark.h"
+#include "yosupo/dsu.hpp"
+#include "yosupo/random.hpp"
+
+static const int N = 1 << 22;
+static const int M = 1 << 23;
+
+static const std::vector<std::pair<int, int>>& edges() {
+    static std::vector<std::pair<int, int>> e = [] {
+        yosupo::Random gen(1);
+        std::vector<std::pair<int, int>> v(M);
+        for (auto& [a, b] : v) {
+            a = yosupo::uniform(0, N - 1, gen);
+            b = yosupo::uniform(0, N - 1, gen);
+        }
+        return v;
+    }();
+    return e;
+}
+
+void BM_AtcoderDSU(benchmark::State& state) {
+    for (auto _ : state) {
+        atcoder::dsu d(N);
+        int cnt = 0;
+        for (auto [a, b] : edges()) {
+            if (!d.same(a, b)) {
+                d.merge(a, b);
+                cnt++;
+            }
+        }
+        benchmark::DoNotOptimize(cnt);
+    }
+}
+BENCHMARK(BM_AtcoderDSU)->Unit(benchmark::kMillisecond);
+
+void BM_RollbackDSU(benchmark::State& state) {
+    for (auto _ : state) {
+        yosupo::RollbackDSU d(N);
+        int cnt = 0;
+        for (auto [a, b] : edges()) {
+            if (!d.same(a, b)) {
+                d.merge(a, b);
+                cnt++;
+            }
+        }
+        benchmark::DoNotOptimize(cnt);
+    }
+}
+BENCHMARK(BM_RollbackDSU)->Unit(benchmark::kMillisecond);
+
+// state.range(0) threads
+void BM_ConcurrentDSU(benchmark::State& state) {
+    int t_num = int(state.range(0));
+    for (auto _ : state) {
+        yosupo::ConcurrentDSU d(N);
+        std::vector<int> cnt(t_num);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < t_num; t++) {
+            threads.emplace_back([&, t] {
+                int c = 0;
+                const auto& e = edges();
+                for (int i = t; i < M; i += t_num) {
+                    c += d.merge(e[i].first, e[i].second);
+                }
+                cnt[t] = c;
+            });
+        }
+        for (auto& th : threads) th.join();
+        benchmark::DoNotOptimize(cnt.data());
+    }
+}
+BENCHMARK(BM_ConcurrentDSU)
+    ->RangeMultiplier(2)
+    ->Range(1, 16)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+BENCHMARK_MAIN();
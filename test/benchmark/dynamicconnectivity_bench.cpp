@@ -0,0 +1,42 @@
+#include <utility>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "yosupo/dynamicconnectivity.hpp"
+#include "yosupo/random.hpp"
+
+// 10^6 events: 1/2 add, 1/4 erase, 1/4 query
+void BM_OfflineDynamicConnectivity(benchmark::State& state) {
+    const int n = int(state.range(0)), m = 1000000;
+    for (auto _ : state) {
+        state.PauseTiming();
+        yosupo::Random gen(1);
+        yosupo::OfflineDynamicConnectivity dc(n);
+        std::vector<std::pair<int, int>> edges;
+        for (int i = 0; i < m; i++) {
+            int ty = yosupo::uniform(0, 3, gen);
+            int u = yosupo::uniform(0, n - 1, gen);
+            int v = yosupo::uniform(0, n - 1, gen);
+            if (ty <= 1) {
+                dc.add_edge(u, v);
+                edges.push_back({u, v});
+            } else if (ty == 2 && !edges.empty()) {
+                int k = yosupo::uniform(0, int(edges.size()) - 1, gen);
+                std::swap(edges[k], edges.back());
+                dc.erase_edge(edges.back().first, edges.back().second);
+                edges.pop_back();
+            } else {
+                dc.same(u, v);
+            }
+        }
+        state.ResumeTiming();
+        auto ans = dc.solve();
+        benchmark::DoNotOptimize(ans.size());
+    }
+}
+BENCHMARK(BM_OfflineDynamicConnectivity)
+    ->Arg(1000)
+    ->Arg(1000000)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
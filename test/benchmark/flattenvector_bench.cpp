@@ -0,0 +1,75 @@
+#include <utility>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "yosupo/flattenvector.hpp"
+#include "yosupo/random.hpp"
+
+static const int N = 1 << 20;
+static const int M = 1 << 23;
+
+// M elements in N random rows
+static const std::vector<std::pair<int, int>>& elements() {
+    static std::vector<std::pair<int, int>> e = [] {
+        yosupo::Random gen(1);
+        std::vector<std::pair<int, int>> v(M);
+        for (auto& [i, x] : v) {
+            i = yosupo::uniform(0, N - 1, gen);
+            x = yosupo::uniform(0, 1 << 30, gen);
+        }
+        return v;
+    }();
+    return e;
+}
+
+// arg: threads
+void BM_FromPairs(benchmark::State& state) {
+    const auto& e = elements();
+    for (auto _ : state) {
+        yosupo::FlattenVector<int> fv(N, e, int(state.range(0)));
+        benchmark::DoNotOptimize(fv.v.data());
+    }
+}
+BENCHMARK(BM_FromPairs)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+void BM_FromGenerator(benchmark::State& state) {
+    const auto& e = elements();
+    for (auto _ : state) {
+        yosupo::FlattenVector<int> fv(N, [&](auto f) {
+            for (auto [i, x] : e) f(i, x);
+        });
+        benchmark::DoNotOptimize(fv.v.data());
+    }
+}
+BENCHMARK(BM_FromGenerator)->Unit(benchmark::kMillisecond);
+
+// arg: threads
+void BM_FromGeneratorThreads(benchmark::State& state) {
+    const auto& e = elements();
+    int threads = int(state.range(0));
+    for (auto _ : state) {
+        yosupo::FlattenVector<int> fv(
+            N,
+            [&](int t, auto f) {
+                for (size_t i = e.size() * t / threads;
+                     i < e.size() * (t + 1) / threads; i++) {
+                    f(e[i].first, e[i].second);
+                }
+            },
+            threads);
+        benchmark::DoNotOptimize(fv.v.data());
+    }
+}
+BENCHMARK(BM_FromGeneratorThreads)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+BENCHMARK_MAIN();
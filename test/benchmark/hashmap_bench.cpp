@@ -0,0 +1,86 @@
+#include <unordered_map>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "yosupo/container/hashmap.hpp"
+#include "yosupo/random.hpp"
+#include "yosupo/types.hpp"
+
+using yosupo::u64;
+
+static std::vector<u64> keys(long long n) {
+    yosupo::Random gen(1);
+    std::vector<u64> v(n);
+    for (auto& x : v) x = yosupo::uniform(u64(0), u64(n) * 4, gen);
+    return v;
+}
+
+static void BM_InsertUnorderedMap(benchmark::State& state) {
+    auto v = keys(state.range(0));
+    for (auto _ : state) {
+        std::unordered_map<u64, u64> mp;
+        for (auto x : v) mp[x]++;
+        benchmark::DoNotOptimize(mp.size());
+    }
+}
+BENCHMARK(BM_InsertUnorderedMap)->Range(1 << 10, 1 << 20);
+
+static void BM_InsertHashMap(benchmark::State& state) {
+    auto v = keys(state.range(0));
+    for (auto _ : state) {
+        yosupo::IncrementalHashMap<u64, u64> mp;
+        for (auto x : v) mp[x]++;
+        benchmark::DoNotOptimize(mp.size());
+    }
+}
+BENCHMARK(BM_InsertHashMap)->Range(1 << 10, 1 << 20);
+
+static void BM_InsertHashMapReserve(benchmark::State& state) {
+    auto v = keys(state.range(0));
+    for (auto _ : state) {
+        yosupo::IncrementalHashMap<u64, u64> mp;
+        mp.reserve(v.size());
+        for (auto x : v) mp[x]++;
+        benchmark::DoNotOptimize(mp.size());
+    }
+}
+BENCHMARK(BM_InsertHashMapReserve)->Range(1 << 10, 1 << 20);
+
+static void BM_FindUnorderedMap(benchmark::State& state) {
+    auto v = keys(state.range(0));
+    std::unordered_map<u64, u64> mp;
+    for (size_t i = 0; i < v.size(); i += 2) mp[v[i]] = i;
+    for (auto _ : state) {
+        u64 sum = 0;
+        for (auto x : v) sum += mp.count(x);
+        benchmark::DoNotOptimize(sum);
+    }
+}
+BENCHMARK(BM_FindUnorderedMap)->Range(1 << 10, 1 << 20);
+
+static void BM_FindHashMap(benchmark::State& state) {
+    auto v = keys(state.range(0));
+    yosupo::IncrementalHashMap<u64, u64> mp;
+    for (size_t i = 0; i < v.size(); i += 2) mp[v[i]] = i;
+    for (auto _ : state) {
+        u64 sum = 0;
+        for (auto x : v) sum += mp.count(x);
+        benchmark::DoNotOptimize(sum);
+    }
+}
+BENCHMARK(BM_FindHashMap)->Range(1 << 10, 1 << 20);
+
+static void BM_EraseHashMap(benchmark::State& state) {
+    auto v = keys(state.range(0));
+    for (auto _ : state) {
+        yosupo::IncrementalHashMap<u64, u64> mp;
+        for (size_t i = 0; i < v.size(); i++) {
+            mp[v[i]]++;
+            if (i >= 100) mp.erase(v[i - 100]);
+        }
+        benchmark::DoNotOptimize(mp.size());
+    }
+}
+BENCHMARK(BM_EraseHashMap)->Range(1 << 10, 1 << 20);
+
+BENCHMARK_MAIN();
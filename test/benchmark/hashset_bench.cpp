@@ -0,0 +1,62 @@
+#include <unordered_set>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "yosupo/container/hashset.hpp"
+#include "yosupo/random.hpp"
+#include "yosupo/types.hpp"
+
+using yosupo::u64;
+
+static std::vector<u64> keys(long long n) {
+    yosupo::Random gen(1);
+    std::vector<u64> v(n);
+    for (auto& x : v) x = yosupo::uniform(u64(0), u64(n) * 4, gen);
+    return v;
+}
+
+static void BM_InsertUnorderedSet(benchmark::State& state) {
+    auto v = keys(state.range(0));
+    for (auto _ : state) {
+        std::unordered_set<u64> st;
+        for (auto x : v) st.insert(x);
+        benchmark::DoNotOptimize(st.size());
+    }
+}
+BENCHMARK(BM_InsertUnorderedSet)->Range(1 << 10, 1 << 20);
+
+static void BM_InsertHashSet(benchmark::State& state) {
+    auto v = keys(state.range(0));
+    for (auto _ : state) {
+        yosupo::IncrementalHashSet<u64> st;
+        for (auto x : v) st.insert(x);
+        benchmark::DoNotOptimize(st.size());
+    }
+}
+BENCHMARK(BM_InsertHashSet)->Range(1 << 10, 1 << 20);
+
+static void BM_ContainsUnorderedSet(benchmark::State& state) {
+    auto v = keys(state.range(0));
+    std::unordered_set<u64> st;
+    for (size_t i = 0; i < v.size(); i += 2) st.insert(v[i]);
+    for (auto _ : state) {
+        u64 sum = 0;
+        for (auto x : v) sum += st.contains(x);
+        benchmark::DoNotOptimize(sum);
+    }
+}
+BENCHMARK(BM_ContainsUnorderedSet)->Range(1 << 10, 1 << 20);
+
+static void BM_ContainsHashSet(benchmark::State& state) {
+    auto v = keys(state.range(0));
+    yosupo::IncrementalHashSet<u64> st;
+    for (size_t i = 0; i < v.size(); i += 2) st.insert(v[i]);
+    for (auto _ : state) {
+        u64 sum = 0;
+        for (auto x : v) sum += st.contains(x);
+        benchmark::DoNotOptimize(sum);
+    }
+}
+BENCHMARK(BM_ContainsHashSet)->Range(1 << 10, 1 << 20);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,68 @@
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "yosupo/hl.hpp"
+#include "yosupo/random.hpp"
+#include "yosupo/tree.hpp"
+
+// parent of i is in [i - w, i), w = n gives a shallow random tree
+// w = 0 gives a complete binary tree, which has many light edges
+static yosupo::RootedTree random_tree(int n, int w) {
+    yosupo::Random gen(1);
+    yosupo::RootedTreeBuilder builder(n);
+    for (int i = 1; i < n; i++) {
+        int p = (w == 0) ? (i - 1) / 2
+                         : yosupo::uniform(std::max(0, i - w), i - 1, gen);
+        builder.add_edge(p, i);
+    }
+    return std::move(builder).build(0);
+}
+
+static std::vector<std::pair<int, int>> random_queries(int n, int q) {
+    yosupo::Random gen(2);
+    std::vector<std::pair<int, int>> qs(q);
+    for (auto& [u, v] : qs) {
+        u = yosupo::uniform(0, n - 1, gen);
+        v = yosupo::uniform(0, n - 1, gen);
+    }
+    return qs;
+}
+
+static const int N = 1 << 20;
+static const int Q = 1 << 22;
+
+void BM_LCA(benchmark::State& state) {
+    yosupo::HLEulerTour hl(random_tree(N, int(state.range(0))));
+    auto qs = random_queries(N, Q);
+    for (auto _ : state) {
+        int sum = 0;
+        for (auto [u, v] : qs) sum ^= hl.lca(u, v);
+        benchmark::DoNotOptimize(sum);
+    }
+}
+BENCHMARK(BM_LCA)->Arg(N)->Arg(8)->Arg(0);
+
+void BM_LCABatch(benchmark::State& state) {
+    yosupo::HLEulerTour hl(random_tree(N, int(state.range(0))));
+    auto qs = random_queries(N, Q);
+    for (auto _ : state) {
+        auto res = hl.lca_batch(qs);
+        benchmark::DoNotOptimize(res.data());
+    }
+}
+BENCHMARK(BM_LCABatch)->Arg(N)->Arg(8)->Arg(0);
+
+void BM_LCARMQ(benchmark::State& state) {
+    yosupo::HLEulerTour hl(random_tree(N, int(state.range(0))), true);
+    auto qs = random_queries(N, Q);
+    for (auto _ : state) {
+        int sum = 0;
+        for (auto [u, v] : qs) sum ^= hl.lca(u, v);
+        benchmark::DoNotOptimize(sum);
+    }
+}
+BENCHMARK(BM_LCARMQ)->Arg(N)->Arg(8)->Arg(0);
+
+BENCHMARK_MAIN();
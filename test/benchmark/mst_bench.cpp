@@ -0,0 +1,54 @@
+#include "benchmark/benchmark.h"
+#include "yosupo/mst.hpp"
+#include "yosupo/random.hpp"
+#include "yosupo/types.hpp"
+
+using yosupo::u32;
+
+static const int N = 1 << 18;
+static const int M = 1 << 23;
+
+static yosupo::MST<u32> random_graph() {
+    yosupo::Random gen(1);
+    yosupo::MST<u32> g(N);
+    for (int i = 0; i < M; i++) {
+        int u = yosupo::uniform(0, N - 1, gen);
+        int v = yosupo::uniform(0, N - 1, gen);
+        g.add_edge(u, v, yosupo::uniform(u32(0), u32(-1), gen));
+    }
+    return g;
+}
+
+void BM_Kruskal(benchmark::State& state) {
+    auto g = random_graph();
+    for (auto _ : state) {
+        auto res = g.mst();
+        benchmark::DoNotOptimize(res.first);
+    }
+}
+BENCHMARK(BM_Kruskal)->Unit(benchmark::kMillisecond);
+
+void BM_FilterKruskal(benchmark::State& state) {
+    auto g = random_graph();
+    for (auto _ : state) {
+        auto res = g.mst_filter_kruskal();
+        benchmark::DoNotOptimize(res.first);
+    }
+}
+BENCHMARK(BM_FilterKruskal)->Unit(benchmark::kMillisecond);
+
+// state.range(0) threads
+void BM_Boruvka(benchmark::State& state) {
+    auto g = random_graph();
+    for (auto _ : state) {
+        auto res = g.mst_boruvka(int(state.range(0)));
+        benchmark::DoNotOptimize(res.first);
+    }
+}
+BENCHMARK(BM_Boruvka)
+    ->Arg(1)
+    ->Arg(4)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+BENCHMARK_MAIN();
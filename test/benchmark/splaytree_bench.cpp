@@ -0,0 +1,106 @@
+#include <algorithm>
+#include <functional>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "yosupo/algebra.hpp"
+#include "yosupo/container/splaytree.hpp"
+#include "yosupo/random.hpp"
+
+struct RangeAddMax {
+    using S = long long;
+    using F = long long;
+
+    yosupo::Max<S> monoid = yosupo::Max<S>(0);
+    yosupo::Monoid<F, std::plus<F>> act = yosupo::Monoid<F, std::plus<F>>(0);
+
+    S mapping(F l, S r) { return l + r; }
+};
+
+using Tree = yosupo::SplayTree<RangeAddMax>;
+
+static const int N = 1 << 18;
+
+// sorted random positions in [0, n]
+static std::vector<int> positions(int n, int m, yosupo::Random& gen) {
+    std::vector<int> pos(m);
+    for (auto& p : pos) p = yosupo::uniform(0, n, gen);
+    std::sort(pos.begin(), pos.end());
+    return pos;
+}
+
+static void BM_Build(benchmark::State& state) {
+    std::vector<long long> v(state.range(0), 1);
+    for (auto _ : state) {
+        Tree tree((RangeAddMax()));
+        auto tr = tree.build(v);
+        benchmark::DoNotOptimize(tree.all_prod(tr));
+    }
+}
+BENCHMARK(BM_Build)->Arg(N);
+
+static void BM_Insert(benchmark::State& state) {
+    int m = int(state.range(0));
+    yosupo::Random gen(1);
+    Tree tree((RangeAddMax()));
+    auto tr = tree.build(std::vector<long long>(N, 1));
+    for (auto _ : state) {
+        auto pos = positions(int(tree.size(tr)), m, gen);
+        for (int i = m - 1; i >= 0; i--) {
+            tree.insert(tr, pos[i], 1);
+        }
+    }
+    benchmark::DoNotOptimize(tree.all_prod(tr));
+}
+BENCHMARK(BM_Insert)->Range(1 << 4, 1 << 14);
+
+static void BM_InsertBatch(benchmark::State& state) {
+    int m = int(state.range(0));
+    yosupo::Random gen(1);
+    Tree tree((RangeAddMax()));
+    auto tr = tree.build(std::vector<long long>(N, 1));
+    for (auto _ : state) {
+        auto pos = positions(int(tree.size(tr)), m, gen);
+        std::vector<std::pair<int, long long>> q;
+        for (int p : pos) q.push_back({p, 1});
+        tree.insert_batch(tr, q);
+    }
+    benchmark::DoNotOptimize(tree.all_prod(tr));
+}
+BENCHMARK(BM_InsertBatch)->Range(1 << 4, 1 << 14);
+
+static void BM_Apply(benchmark::State& state) {
+    int m = int(state.range(0));
+    yosupo::Random gen(1);
+    Tree tree((RangeAddMax()));
+    auto tr = tree.build(std::vector<long long>(N, 1));
+    for (auto _ : state) {
+        auto pos = positions(N, 2 * m, gen);
+        for (int i = 0; i < m; i++) {
+            tree.apply(tr, pos[2 * i], pos[2 * i + 1], 1);
+        }
+    }
+    benchmark::DoNotOptimize(tree.all_prod(tr));
+}
+BENCHMARK(BM_Apply)->Range(1 << 4, 1 << 14);
+
+static void BM_ApplyBatch(benchmark::State& state) {
+    int m = int(state.range(0));
+    yosupo::Random gen(1);
+    Tree tree((RangeAddMax()));
+    auto tr = tree.build(std::vector<long long>(N, 1));
+    for (auto _ : state) {
+        auto pos = positions(N, 2 * m, gen);
+        std::vector<std::tuple<int, int, long long>> q;
+        for (int i = 0; i < m; i++) {
+            q.push_back({pos[2 * i], pos[2 * i + 1], 1});
+        }
+        tree.apply_batch(tr, q);
+    }
+    benchmark::DoNotOptimize(tree.all_prod(tr));
+}
+BENCHMARK(BM_ApplyBatch)->Range(1 << 4, 1 << 14);
+
+BENCHMARK_MAIN();
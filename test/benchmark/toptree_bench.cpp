@@ -0,0 +1,178 @@
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "yosupo/algebra.hpp"
+#include "yosupo/dynamictoptree.hpp"
+#include "yosupo/random.hpp"
+#include "yosupo/toptree.hpp"
+#include "yosupo/tree.hpp"
+#include "yosupo/types.hpp"
+
+using yosupo::u64;
+
+// h(u) = v_u + K * sum h(children)
+struct TreeHashDP {
+    static constexpr u64 K = 1000003;
+
+    using Point = u64;
+    // x -> a * x + b
+    using Path = std::pair<u64, u64>;
+    using Vertex = u64;
+
+    struct Compose {
+        Path operator()(const Path& l, const Path& r) const {
+            return {l.first * r.first, l.first * r.second + l.second};
+        }
+    };
+
+    yosupo::Sum<Point> point = yosupo::Sum<Point>(0);
+    yosupo::Monoid<Path, Compose> path =
+        yosupo::Monoid<Path, Compose>(Path(1, 0));
+
+    Path add_vertex(Point x, Vertex v) { return {K, v + K * x}; }
+    Point add_edge(Path x) { return x.second; }
+};
+
+// parent of i is in [i - w, i), w = n gives a shallow random tree
+static yosupo::RootedTree random_tree(int n, int w = -1) {
+    if (w == -1) w = n;
+    yosupo::Random gen(1);
+    yosupo::RootedTreeBuilder builder(n);
+    for (int i = 1; i < n; i++) {
+        builder.add_edge(yosupo::uniform(std::max(0, i - w), i - 1, gen), i);
+    }
+    return std::move(builder).build(0);
+}
+
+static std::vector<std::pair<int, u64>> random_updates(int n, int k) {
+    yosupo::Random gen(2);
+    std::vector<std::pair<int, u64>> updates(k);
+    for (auto& [u, x] : updates) {
+        u = yosupo::uniform(0, n - 1, gen);
+        x = yosupo::uniform(u64(0), u64(-1), gen);
+    }
+    return updates;
+}
+
+static const int N = 1 << 20;
+
+static void BM_Update(benchmark::State& state) {
+    yosupo::StaticTopTree<TreeHashDP> tt(random_tree(N), std::vector<u64>(N));
+    auto updates = random_updates(N, int(state.range(0)));
+    for (auto _ : state) {
+        for (auto [u, x] : updates) tt.update(u, x);
+        benchmark::DoNotOptimize(tt.all_prod());
+    }
+}
+BENCHMARK(BM_Update)->Range(1 << 8, N);
+
+static void BM_UpdateBatch(benchmark::State& state) {
+    yosupo::StaticTopTree<TreeHashDP> tt(random_tree(N), std::vector<u64>(N));
+    auto updates = random_updates(N, int(state.range(0)));
+    for (auto _ : state) {
+        tt.update_batch(updates);
+        benchmark::DoNotOptimize(tt.all_prod());
+    }
+}
+BENCHMARK(BM_UpdateBatch)->Range(1 << 8, N);
+
+// args: batch size, threads
+static void BM_UpdateBatchThreads(benchmark::State& state) {
+    yosupo::StaticTopTree<TreeHashDP> tt(random_tree(N), std::vector<u64>(N));
+    auto updates = random_updates(N, int(state.range(0)));
+    for (auto _ : state) {
+        tt.update_batch(updates, int(state.range(1)));
+        benchmark::DoNotOptimize(tt.all_prod());
+    }
+}
+BENCHMARK(BM_UpdateBatchThreads)
+    ->ArgsProduct({{1 << 14, N}, {1, 2, 4}})
+    ->UseRealTime();
+
+// latency of single update / path_prod on large trees
+static void BM_UpdateLarge(benchmark::State& state) {
+    int n = 1 << 22;
+    yosupo::StaticTopTree<TreeHashDP> tt(random_tree(n, int(state.range(0))),
+                                         std::vector<u64>(n));
+    auto updates = random_updates(n, 1 << 16);
+    for (auto _ : state) {
+        for (auto [u, x] : updates) tt.update(u, x);
+        benchmark::DoNotOptimize(tt.all_prod());
+    }
+}
+BENCHMARK(BM_UpdateLarge)->Arg(1 << 22)->Arg(8);
+
+static void BM_PathProdLarge(benchmark::State& state) {
+    int n = 1 << 22;
+    yosupo::StaticTopTree<TreeHashDP> tt(random_tree(n, int(state.range(0))),
+                                         std::vector<u64>(n));
+    auto updates = random_updates(n, 1 << 16);
+    for (auto _ : state) {
+        u64 sum = 0;
+        for (auto [u, x] : updates) sum += tt.path_prod(u).second;
+        benchmark::DoNotOptimize(sum);
+    }
+}
+BENCHMARK(BM_PathProdLarge)->Arg(1 << 22)->Arg(8);
+
+// move a random subtree under another vertex, then query the whole tree
+static std::vector<std::pair<int, int>> random_moves(int n, int q) {
+    yosupo::Random gen(3);
+    std::vector<std::pair<int, int>> moves(q);
+    for (auto& [u, p] : moves) {
+        u = yosupo::uniform(1, n - 1, gen);
+        p = yosupo::uniform(0, u - 1, gen);
+    }
+    return moves;
+}
+
+static void BM_MoveDynamic(benchmark::State& state) {
+    int n = int(state.range(0));
+    auto moves = random_moves(n, 1000);
+    for (auto _ : state) {
+        yosupo::Random gen(1);
+        yosupo::DynamicTopTree<TreeHashDP> tt(std::vector<u64>(n, 1));
+        std::vector<int> par(n, -1);
+        for (int i = 1; i < n; i++) {
+            par[i] = yosupo::uniform(0, i - 1, gen);
+            tt.link(i, par[i]);
+        }
+        u64 sum = 0;
+        for (auto [u, p] : moves) {
+            tt.cut(u, par[u]);
+            tt.link(u, p);
+            par[u] = p;
+            tt.evert(0);
+            sum += tt.all_prod(0);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+BENCHMARK(BM_MoveDynamic)->Arg(1 << 10)->Arg(1 << 14);
+
+static void BM_MoveStaticRebuild(benchmark::State& state) {
+    int n = int(state.range(0));
+    auto moves = random_moves(n, 1000);
+    for (auto _ : state) {
+        yosupo::Random gen(1);
+        std::vector<int> par(n, -1);
+        for (int i = 1; i < n; i++) {
+            par[i] = yosupo::uniform(0, i - 1, gen);
+        }
+        u64 sum = 0;
+        for (auto [u, p] : moves) {
+            par[u] = p;
+            yosupo::RootedTreeBuilder builder(n);
+            for (int i = 1; i < n; i++) builder.add_edge(par[i], i);
+            yosupo::StaticTopTree<TreeHashDP> tt(std::move(builder).build(0),
+                                                 std::vector<u64>(n, 1));
+            sum += tt.all_prod();
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+BENCHMARK(BM_MoveStaticRebuild)->Arg(1 << 10)->Arg(1 << 14);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,86 @@
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <malloc.h>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "yosupo/random.hpp"
+#include "yosupo/tree.hpp"
+
+// track the peak heap usage, allocations may come from worker threads
+static std::atomic<size_t> cur_bytes = 0, peak_bytes = 0;
+
+__attribute__((noinline)) void* operator new(size_t size) {
+    void* p = std::malloc(size);
+    if (!p) throw std::bad_alloc();
+    size_t cur = cur_bytes += malloc_usable_size(p);
+    size_t peak = peak_bytes.load();
+    while (peak < cur && !peak_bytes.compare_exchange_weak(peak, cur)) {
+    }
+    return p;
+}
+__attribute__((noinline)) void operator delete(void* p) noexcept {
+    if (!p) return;
+    cur_bytes -= malloc_usable_size(p);
+    std::free(p);
+}
+void operator delete(void* ptr, size_t) noexcept { operator delete(ptr); }
+
+static std::vector<int> random_parents(int n) {
+    yosupo::Random gen(1);
+    std::vector<int> par(n, -1);
+    for (int i = 1; i < n; i++) par[i] = yosupo::uniform(0, i - 1, gen);
+    return par;
+}
+
+static const int N = 1 << 22;
+
+// arg: threads
+void BM_BuildFromEdges(benchmark::State& state) {
+    auto par = random_parents(N);
+    size_t peak = 0;
+    for (auto _ : state) {
+        size_t base = cur_bytes;
+        peak_bytes = base;
+        yosupo::RootedTreeBuilder builder(N);
+        for (int i = 1; i < N; i++) builder.add_edge(par[i], i);
+        auto tree = std::move(builder).build(0, int(state.range(0)));
+        benchmark::DoNotOptimize(tree.topo.data());
+        peak = peak_bytes - base;
+    }
+    state.counters["peak_bytes_per_vertex"] = double(peak) / N;
+}
+BENCHMARK(BM_BuildFromEdges)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+// arg: threads
+void BM_BuildFromPar(benchmark::State& state) {
+    auto par = random_parents(N);
+    size_t peak = 0;
+    for (auto _ : state) {
+        auto p = par;
+        size_t base = cur_bytes;
+        peak_bytes = base;
+        auto tree =
+            yosupo::rooted_tree_from_par(std::move(p), int(state.range(0)));
+        benchmark::DoNotOptimize(tree.topo.data());
+        peak = peak_bytes - base;
+    }
+    state.counters["peak_bytes_per_vertex"] = double(peak) / N;
+}
+BENCHMARK(BM_BuildFromPar)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+BENCHMARK_MAIN();
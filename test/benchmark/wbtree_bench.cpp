@@ -0,0 +1,73 @@
+#include <functional>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "yosupo/algebra.hpp"
+#include "yosupo/container/splaytree.hpp"
+#include "yosupo/container/wbtree.hpp"
+#include "yosupo/random.hpp"
+
+struct RangeAddMax {
+    using S = long long;
+    using F = long long;
+
+    yosupo::Max<S> monoid = yosupo::Max<S>(0);
+    yosupo::Monoid<F, std::plus<F>> act = yosupo::Monoid<F, std::plus<F>>(0);
+
+    S mapping(F l, S r) { return l + r; }
+};
+
+// dynamic sequence: insert, erase, range add, range max
+template <class Tree> static void BM_DynamicSeq(benchmark::State& state) {
+    int n = int(state.range(0));
+    for (auto _ : state) {
+        yosupo::Random gen(1);
+        Tree tree((RangeAddMax()));
+        auto tr = tree.build(std::vector<long long>(n, 1));
+        long long sum = 0;
+        for (int i = 0; i < n; i++) {
+            int sz = int(tree.size(tr));
+            int ty = yosupo::uniform(0, 3, gen);
+            int l = yosupo::uniform(0, sz, gen), r = yosupo::uniform(0, sz, gen);
+            if (l > r) std::swap(l, r);
+            if (ty == 0 || sz == 0) {
+                tree.insert(tr, l, i);
+            } else if (ty == 1) {
+                tree.erase(tr, l % sz);
+            } else if (ty == 2) {
+                tree.apply(tr, l, r, 1);
+            } else {
+                sum += tree.prod(tr, l, r);
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+BENCHMARK(BM_DynamicSeq<yosupo::SplayTree<RangeAddMax>>)
+    ->Arg(1 << 12)
+    ->Arg(1 << 18);
+BENCHMARK(BM_DynamicSeq<yosupo::WBTree<RangeAddMax>>)
+    ->Arg(1 << 12)
+    ->Arg(1 << 18);
+BENCHMARK(BM_DynamicSeq<yosupo::PersistentWBTree<RangeAddMax>>)
+    ->Arg(1 << 12)
+    ->Arg(1 << 18);
+
+// point get, which restructures the splay tree but not the wbtree
+template <class Tree> static void BM_Get(benchmark::State& state) {
+    int n = int(state.range(0));
+    Tree tree((RangeAddMax()));
+    auto tr = tree.build(std::vector<long long>(n, 1));
+    yosupo::Random gen(1);
+    for (auto _ : state) {
+        long long sum = 0;
+        for (int i = 0; i < n; i++) {
+            sum += tree.get(tr, yosupo::uniform(0, n - 1, gen));
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+BENCHMARK(BM_Get<yosupo::SplayTree<RangeAddMax>>)->Arg(1 << 12)->Arg(1 << 18);
+BENCHMARK(BM_Get<yosupo::WBTree<RangeAddMax>>)->Arg(1 << 12)->Arg(1 << 18);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,49 @@
+// clang-format off
+// verification-helper: PROBLEM https://judge.yosupo.jp/problem/vertex_add_path_sum
+// clang-format on
+
+#include <utility>
+#include <vector>
+
+#include "yosupo/algebra.hpp"
+#include "yosupo/fastio.hpp"
+#include "yosupo/hl.hpp"
+#include "yosupo/tree.hpp"
+
+yosupo::Scanner sc = yosupo::Scanner(stdin);
+yosupo::Printer pr = yosupo::Printer(stdout);
+
+using ll = long long;
+
+int main() {
+    int n, q;
+    sc.read(n, q);
+    std::vector<ll> a(n);
+    for (int i = 0; i < n; i++) {
+        sc.read(a[i]);
+    }
+
+    yosupo::RootedTreeBuilder tree(n);
+    for (int i = 0; i < n - 1; i++) {
+        int u, v;
+        sc.read(u, v);
+        tree.add_edge(u, v);
+    }
+    yosupo::HLPathQuery pq(std::move(tree).build(0), a, yosupo::Sum<ll>(0));
+
+    for (int i = 0; i < q; i++) {
+        int t;
+        sc.read(t);
+        if (t == 0) {
+            int p;
+            ll x;
+            sc.read(p, x);
+            pq.set(p, pq.get(p) + x);
+        } else {
+            int u, v;
+            sc.read(u, v);
+            pr.writeln(pq.prod(u, v));
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,52 @@
+#include "yosupo/container/arena.hpp"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace yosupo;
+
+TEST(NodeArenaTest, Usage) {
+    NodeArena<int, 2> arena;
+    std::vector<int> ids;
+    for (int i = 0; i < 10; i++) {
+        ids.push_back(arena.alloc(i));
+    }
+    const int* p = &arena[ids[0]];
+    for (int i = 0; i < 100; i++) {
+        arena.alloc(i);
+    }
+    // nodes never move
+    EXPECT_EQ(p, &arena[ids[0]]);
+    EXPECT_EQ(110, arena.size());
+
+    arena.free(ids[3]);
+    EXPECT_EQ(109, arena.size());
+    EXPECT_EQ(ids[3], arena.alloc(-1));
+    EXPECT_EQ(-1, arena[ids[3]]);
+    EXPECT_EQ(9, arena[ids[9]]);
+}
+
+TEST(NodeArenaTest, Clear) {
+    NodeArena<int, 2> arena;
+    for (int i = 0; i < 10; i++) {
+        arena.alloc(i);
+    }
+    size_t cap = arena.capacity();
+    arena.clear();
+    EXPECT_EQ(0, arena.size());
+    EXPECT_EQ(0, arena.alloc(5));
+    EXPECT_EQ(cap, arena.capacity());
+}
+
+TEST(NodeArenaTest, Copy) {
+    NodeArena<int, 2> arena;
+    for (int i = 0; i < 10; i++) {
+        arena.alloc(i);
+    }
+    auto arena2 = arena;
+    arena2[3] = 100;
+    EXPECT_EQ(3, arena[3]);
+    EXPECT_EQ(100, arena2[3]);
+    EXPECT_EQ(10, arena2.size());
+}
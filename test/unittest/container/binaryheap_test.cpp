@@ -85,3 +85,33 @@ TEST(BinaryHeapTest, Reverse) {
     ASSERT_EQ(3, h.size());
     ASSERT_EQ(3, std::ssize(h));
 }
+
+TEST(BinaryHeapTest, Dary) {
+    auto stress = [&](auto manager) {
+        for (int ph = 0; ph < 1000; ph++) {
+            int n = uniform(1, 100);
+            std::vector<int> v(n);
+            for (auto& x : v) x = uniform(1, 50);
+
+            auto h0 = manager.build(v);
+            auto h1 = manager.build();
+            std::priority_queue<int> pq(v.begin(), v.end());
+            for (int i = 0; i < n; i++) {
+                int x = uniform(1, 50);
+                manager.push(h1, x);
+                pq.push(x);
+            }
+            manager.meld(h0, h1);
+            ASSERT_TRUE(h1.empty());
+            while (!pq.empty()) {
+                ASSERT_EQ(pq.top(), manager.top(h0));
+                manager.pop(h0);
+                pq.pop();
+            }
+            ASSERT_TRUE(h0.empty());
+        }
+    };
+    stress(MeldableDaryHeapManager<int, std::less<int>, 3>());
+    stress(MeldableDaryHeapManager<int, std::less<int>, 4>());
+    stress(MeldableDaryHeapManager<int, std::less<int>, 8>());
+}
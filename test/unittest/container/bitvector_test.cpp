@@ -0,0 +1,115 @@
+#include "yosupo/container/bitvector.hpp"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "yosupo/random.hpp"
+
+using namespace yosupo;
+
+TEST(SuccinctBitVecTest, Usage) {
+    BitVec bv(5);
+    bv.set(1);
+    bv.set(3);
+    SuccinctBitVec sb(bv);
+    ASSERT_EQ(5, sb.size());
+    ASSERT_EQ(0, sb.rank1(1));
+    ASSERT_EQ(1, sb.rank1(2));
+    ASSERT_EQ(2, sb.rank1(5));
+    ASSERT_EQ(3, sb.rank0(5));
+    ASSERT_EQ(1, sb.select1(0));
+    ASSERT_EQ(3, sb.select1(1));
+    ASSERT_EQ(5, sb.select1(2));
+    ASSERT_EQ(0, sb.select0(0));
+    ASSERT_EQ(4, sb.select0(2));
+    ASSERT_EQ(5, sb.select0(3));
+}
+
+TEST(SuccinctBitVecTest, Empty) {
+    SuccinctBitVec sb;
+    ASSERT_EQ(0, sb.size());
+    ASSERT_EQ(0, sb.rank1(0));
+    ASSERT_EQ(0, sb.select1(0));
+    ASSERT_EQ(0, sb.select0(0));
+}
+
+TEST(SuccinctBitVecTest, Stress) {
+    for (int n : {1, 63, 64, 65, 511, 512, 513, 10000, 100000}) {
+        for (int ratio : {0, 1, 50, 99, 100}) {
+            BitVec bv(n);
+            std::vector<size_t> ones, zeros, rank(n + 1);
+            for (int i = 0; i < n; i++) {
+                bool f = uniform(0, 99) < ratio;
+                bv.set(i, f);
+                (f ? ones : zeros).push_back(i);
+                rank[i + 1] = rank[i] + f;
+            }
+            SuccinctBitVec sb(bv);
+            for (int i = 0; i <= n; i++) ASSERT_EQ(rank[i], sb.rank1(i));
+            for (size_t k = 0; k < ones.size(); k++) {
+                ASSERT_EQ(ones[k], sb.select1(k));
+            }
+            ASSERT_EQ(n, sb.select1(ones.size()));
+            for (size_t k = 0; k < zeros.size(); k++) {
+                ASSERT_EQ(zeros[k], sb.select0(k));
+            }
+            ASSERT_EQ(n, sb.select0(zeros.size()));
+        }
+    }
+}
+
+TEST(BitVecTest, FindNext) {
+    BitVec bv(200);
+    bv.set(3);
+    bv.set(130);
+    ASSERT_EQ(3, bv.find_next(0));
+    ASSERT_EQ(3, bv.find_next(3));
+    ASSERT_EQ(130, bv.find_next(4));
+    ASSERT_EQ(200, bv.find_next(131));
+    ASSERT_EQ(200, bv.find_next(200));
+}
+
+TEST(BitVecTest, CountRange) {
+    for (int n : {1, 64, 100, 300}) {
+        BitVec bv(n);
+        for (int i = 0; i < n; i++) bv.set(i, uniform(0, 1));
+        for (int l = 0; l <= n; l++) {
+            size_t expected = 0;
+            for (int r = l; r <= n; r++) {
+                ASSERT_EQ(expected, bv.count_range(l, r));
+                if (r < n && bv.test(r)) expected++;
+            }
+        }
+    }
+}
+
+TEST(BitVecTest, OrShifted) {
+    for (int n : {1, 63, 64, 65, 300}) {
+        for (int ph = 0; ph < 50; ph++) {
+            BitVec a(n), b(n);
+            for (int i = 0; i < n; i++) {
+                a.set(i, uniform(0, 3) == 0);
+                b.set(i, uniform(0, 3) == 0);
+            }
+            size_t s = uniform(0, n + 70);
+            BitVec expected = a | (b << s);
+            ASSERT_EQ(expected, BitVec(a).or_shifted(b, s));
+
+            BitVec self = a;
+            self.or_shifted(self, s);
+            ASSERT_EQ(a | (a << s), self);
+        }
+    }
+}
+
+TEST(BitVecTest, SubsetSum) {
+    std::vector<int> w = {3, 5, 7};
+    BitVec dp(20);
+    dp.set(0);
+    for (int x : w) dp.or_shifted(dp, x);
+    std::vector<int> actual;
+    for (int i = dp.find_next(0); i < 20; i = dp.find_next(i + 1)) {
+        actual.push_back(i);
+    }
+    ASSERT_EQ((std::vector<int>{0, 3, 5, 7, 8, 10, 12, 15}), actual);
+}
@@ -0,0 +1,61 @@
+#include "yosupo/container/concurrenthashmap.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <map>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "yosupo/random.hpp"
+
+using namespace yosupo;
+
+TEST(ConcurrentHashMapTest, Usage) {
+    ConcurrentHashMap<int, int> mp;
+    mp.insert_or_assign(1, 10);
+    mp.upsert(1, 5, std::plus<int>());
+    mp.upsert(2, 7, std::plus<int>());
+    ASSERT_EQ(15, mp.get(1));
+    ASSERT_EQ(7, mp.get(2));
+    ASSERT_EQ(std::nullopt, mp.get(3));
+    ASSERT_TRUE(mp.contains(2));
+    ASSERT_EQ(2, mp.size());
+    ASSERT_EQ(1, mp.erase(2));
+    ASSERT_FALSE(mp.contains(2));
+    ASSERT_EQ(1, mp.size());
+}
+
+TEST(ConcurrentHashMapTest, CompareWithMap) {
+    ConcurrentHashMap<int, int> mp(2);
+    std::map<int, int> expect;
+    for (int i = 0; i < 10000; i++) {
+        int k = uniform(0, 999), v = uniform(0, 100);
+        mp.upsert(k, v, [](int a, int b) { return std::max(a, b); });
+        expect[k] = std::max(expect[k], v);
+    }
+    std::vector<std::pair<int, int>> actual;
+    mp.for_each([&](int k, int v) { actual.emplace_back(k, v); });
+    std::ranges::sort(actual);
+    ASSERT_EQ((std::vector<std::pair<int, int>>(expect.begin(), expect.end())),
+              actual);
+}
+
+TEST(ConcurrentHashMapTest, MultiThread) {
+    ConcurrentHashMap<int, int> mp;
+    const int T = 4, N = 10000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < T; t++) {
+        threads.emplace_back([&] {
+            for (int i = 0; i < N; i++) mp.upsert(i % 100, 1, std::plus<int>());
+        });
+    }
+    for (auto& th : threads) th.join();
+
+    ASSERT_EQ(100, mp.size());
+    std::atomic<int> sum = 0;
+    mp.for_each([&](int, int v) { sum += v; }, T);
+    ASSERT_EQ(T * N, sum);
+}
@@ -47,3 +47,17 @@ TEST(DynamicSegtreeTest, SetE) {
     tree.set_e(tr, 2);
     EXPECT_EQ(tree.all_prod(tr), 11001);
 }
+
+TEST(DynamicSegtreeTest, Clear) {
+    yosupo::DynamicSegtree tree((yosupo::ActedMonoid(yosupo::Sum<int>(0))));
+    auto tr = tree.build(1 << 30);
+    auto tr2 = tree.build(10);
+    tree.set(tr, 0, 1);
+    tree.set(tr, 1, 10);
+    tree.set(tr2, 3, 100);
+    tree.clear(tr);
+    EXPECT_EQ(tree.all_prod(tr), 0);
+    EXPECT_EQ(tree.all_prod(tr2), 100);
+    tree.set(tr, 2, 1000);
+    EXPECT_EQ(tree.all_prod(tr), 1000);
+}
@@ -5,10 +5,12 @@
 #include <limits>
 #include <ranges>
 #include <set>
+#include <utility>
 #include <vector>
 
 #include "gtest/gtest.h"
 #include "yosupo/random.hpp"
+#include "yosupo/util.hpp"
 
 using namespace yosupo;
 using ll = long long;
@@ -124,3 +126,54 @@ TEST(FastSetTest, OutOfRange) {
     ASSERT_EQ(9, f.or_less(std::numeric_limits<int>::max()));
     ASSERT_EQ(9, f.less(std::numeric_limits<int>::max()));
 }
+
+TEST(FastSetTest, Range) {
+    FastSet f(10);
+    f.set_range(2, 8);
+    ASSERT_EQ((std::vector<int>{2, 3, 4, 5, 6, 7}), to_vec(f));
+    f.reset_range(3, 6);
+    ASSERT_EQ((std::vector<int>{2, 6, 7}), to_vec(f));
+    ASSERT_EQ((std::vector<int>{6, 7}), f.next_k(3, 5));
+    ASSERT_EQ((std::vector<int>{2}), f.next_k(0, 1));
+    ASSERT_EQ((std::vector<int>{}), f.next_k(8, 1));
+
+    std::vector<int> idx = {0, 2, 9};
+    bool out[3];
+    f.get(idx, out);
+    ASSERT_FALSE(out[0]);
+    ASSERT_TRUE(out[1]);
+    ASSERT_FALSE(out[2]);
+}
+
+TEST(FastSetTest, RangeStress) {
+    for (int n : {1, 2, 63, 64, 65, 200, 4095, 4096, 4097, 300000}) {
+        FastSet f(n);
+        std::set<int> st;
+        for (int ph = 0; ph < 200; ph++) {
+            int ty = uniform(0, 2);
+            int l = uniform(0, n);
+            int r = uniform(0, n);
+            if (l > r) std::swap(l, r);
+            if (ty == 0) {
+                f.set_range(l, r);
+                for (int i = l; i < r; i++) st.insert(i);
+            } else if (ty == 1) {
+                f.reset_range(l, r);
+                st.erase(st.lower_bound(l), st.lower_bound(r));
+            } else {
+                int k = uniform(0, 100);
+                std::vector<int> expected;
+                for (auto it = st.lower_bound(l);
+                     it != st.end() && int(expected.size()) < k; it++) {
+                    expected.push_back(*it);
+                }
+                ASSERT_EQ(expected, f.next_k(l, k));
+            }
+            int p = uniform(0, n - 1);
+            ASSERT_EQ(st.count(p), f[p]);
+            auto it = st.lower_bound(p);
+            ASSERT_EQ(it == st.end() ? n : *it, f.or_more(p));
+            ASSERT_EQ(it == st.begin() ? -1 : *prev(it), f.less(p));
+        }
+    }
+}
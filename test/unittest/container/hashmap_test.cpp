@@ -1,12 +1,14 @@
 #include "yosupo/container/hashmap.hpp"
 
 #include <algorithm>
+#include <map>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "gtest/gtest.h"
 #include "yosupo/dump.hpp"
+#include "yosupo/random.hpp"
 
 using namespace yosupo;
 using ll = long long;
@@ -116,3 +118,81 @@ TEST(HashMapTest, Dump) {
     h_single[10] = "ten";
     ASSERT_EQ("{10: ten}", dump(h_single));
 }
+
+TEST(HashMapTest, Erase) {
+    IncrementalHashMap<int, int> h;
+    h[1] = 10;
+    h[2] = 20;
+    ASSERT_EQ(1, h.erase(1));
+    ASSERT_EQ(0, h.erase(1));
+    ASSERT_FALSE(h.contains(1));
+    ASSERT_TRUE(h.contains(2));
+    ASSERT_EQ(1, h.size());
+    ASSERT_EQ(0, h[1]);
+    ASSERT_EQ(2, h.size());
+}
+
+TEST(HashMapTest, CompareWithMap) {
+    IncrementalHashMap<int, int> h;
+    std::map<int, int> mp;
+    for (int ph = 0; ph < 100000; ph++) {
+        int k = uniform(0, 999);
+        int ty = uniform(0, 2);
+        if (ty == 0) {
+            int v = uniform(0, 100);
+            h[k] = v;
+            mp[k] = v;
+        } else if (ty == 1) {
+            ASSERT_EQ(mp.erase(k), h.erase(k));
+        } else {
+            auto it = h.find(k);
+            ASSERT_EQ(mp.count(k), h.count(k));
+            if (mp.count(k)) {
+                ASSERT_EQ(mp[k], it->second);
+            }
+        }
+        ASSERT_EQ(mp.size(), h.size());
+    }
+    auto actual = std::vector<std::pair<int, int>>(h.begin(), h.end());
+    std::ranges::sort(actual);
+    auto expect = std::vector<std::pair<int, int>>(mp.begin(), mp.end());
+    ASSERT_EQ(expect, actual);
+}
+
+TEST(HashMapTest, Reserve) {
+    IncrementalHashMap<int, int> h;
+    h[-1] = -1;
+    h.reserve(1000);
+    for (int i = 0; i < 1000; i++) h[i] = i;
+    ASSERT_EQ(1001, h.size());
+    for (int i = -1; i < 1000; i++) ASSERT_EQ(i, h[i]);
+}
+
+TEST(HashMapTest, IterateWhileMigrating) {
+    IncrementalHashMap<int, int> h;
+    std::map<int, int> mp;
+    for (int i = 0; i < 10000; i++) {
+        h[i] = i;
+        mp[i] = i;
+        if (i % 1000 == 999) {
+            auto actual = std::vector<std::pair<int, int>>(h.begin(), h.end());
+            std::ranges::sort(actual);
+            auto expect =
+                std::vector<std::pair<int, int>>(mp.begin(), mp.end());
+            ASSERT_EQ(expect, actual);
+        }
+    }
+}
+
+TEST(HashMapTest, ReferenceStableOnLookup) {
+    IncrementalHashMap<int, std::vector<int>> h;
+    for (int n = 1; n <= 3000; n++) {
+        h[n - 1] = {n - 1};
+        // holding a reference across lookups / erase while migrating
+        int j = (n - 1) / 2;
+        auto& r = h[j];
+        for (int i = 0; i < n; i += 3) ASSERT_EQ(std::vector<int>({i}), h[i]);
+        h.erase(-1);
+        ASSERT_EQ(std::vector<int>({j}), r);
+    }
+}
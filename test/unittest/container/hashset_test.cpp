@@ -89,3 +89,19 @@ TEST(HashSetTest, Dump) {
     h_single.insert("hello");
     ASSERT_EQ("{hello}", dump(h_single));
 }
+
+TEST(HashSetTest, Erase) {
+    IncrementalHashSet<int> h;
+    std::set<int> s;
+    for (int i = 0; i < 100000; i++) {
+        int val = uniform(0, 999);
+        if (uniform_bool()) {
+            h.insert(val);
+            s.insert(val);
+        } else {
+            EXPECT_EQ(s.erase(val), h.erase(val));
+        }
+        EXPECT_EQ(h.contains(val), s.count(val) > 0);
+        EXPECT_EQ(h.size(), s.size());
+    }
+}
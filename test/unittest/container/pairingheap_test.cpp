@@ -0,0 +1,110 @@
+#include "yosupo/container/pairingheap.hpp"
+
+#include <functional>
+#include <iterator>
+#include <queue>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "yosupo/random.hpp"
+
+using namespace yosupo;
+
+TEST(PairingHeapTest, Usage) {
+    PairingHeapManager<int> manager;
+
+    auto h = manager.build({1, 2, 3});
+    ASSERT_EQ(3, h.size());
+    ASSERT_EQ(3, std::ssize(h));
+    ASSERT_EQ(3, manager.top(h));
+
+    int id = manager.push(h, 0);
+    manager.decrease_key(h, id, 10);
+    ASSERT_EQ(10, manager.top(h));
+    ASSERT_EQ(10, manager.get(id));
+    manager.pop(h);
+    ASSERT_EQ(3, manager.top(h));
+}
+
+TEST(PairingHeapTest, Meld) {
+    PairingHeapManager<int> manager;
+
+    auto h0 = manager.build({1, 2, 3});
+    auto h1 = manager.build({4, 5});
+
+    manager.meld(h0, h1);
+
+    ASSERT_EQ(5, manager.top(h0));
+    ASSERT_EQ(5, h0.size());
+    ASSERT_TRUE(h1.empty());
+}
+
+TEST(PairingHeapTest, PopPush) {
+    PairingHeapManager<int, std::greater<int>> manager;
+
+    auto h = manager.build({1, 2, 3});
+
+    ASSERT_EQ(manager.top(h), 1);
+    manager.pop_push(h, 4);
+    ASSERT_EQ(manager.top(h), 2);
+    manager.pop(h);
+    ASSERT_EQ(manager.top(h), 3);
+    manager.pop(h);
+    ASSERT_EQ(manager.top(h), 4);
+    manager.pop(h);
+    ASSERT_TRUE(h.empty());
+}
+
+TEST(PairingHeapTest, Stress) {
+    for (int ph = 0; ph < 1000; ph++) {
+        PairingHeapManager<std::pair<int, int>, std::greater<>> manager;
+        std::vector<PairingHeapManager<std::pair<int, int>,
+                                       std::greater<>>::Heap>
+            h(2);
+        std::vector<std::set<std::pair<int, int>>> s(2);
+        // (heap, node id) for each alive element
+        std::vector<std::pair<int, int>> alive;
+
+        for (int i = 0; i < 200; i++) {
+            int ty = uniform(0, 3);
+            if (ty == 0) {
+                int k = uniform(0, 1);
+                std::pair<int, int> x = {uniform(0, 100), i};
+                alive.push_back({k, manager.push(h[k], x)});
+                s[k].insert(x);
+            } else if (ty == 1) {
+                if (alive.empty()) continue;
+                int j = uniform(0, int(alive.size()) - 1);
+                auto [k, id] = alive[j];
+                auto x = manager.get(id);
+                s[k].erase(x);
+                x.first -= uniform(0, 10);
+                manager.decrease_key(h[k], id, x);
+                s[k].insert(x);
+            } else if (ty == 2) {
+                int k = uniform(0, 1);
+                if (s[k].empty()) continue;
+                auto x = manager.top(h[k]);
+                ASSERT_EQ(*s[k].begin(), x);
+                std::erase_if(alive, [&](auto p) {
+                    return manager.get(p.second) == x;
+                });
+                manager.pop(h[k]);
+                s[k].erase(s[k].begin());
+            } else {
+                manager.meld(h[0], h[1]);
+                s[0].insert(s[1].begin(), s[1].end());
+                s[1].clear();
+                for (auto& p : alive) p.first = 0;
+            }
+            for (int k = 0; k < 2; k++) {
+                ASSERT_EQ(s[k].size(), h[k].size());
+                if (!s[k].empty()) {
+                    ASSERT_EQ(*s[k].begin(), manager.top(h[k]));
+                }
+            }
+        }
+    }
+}
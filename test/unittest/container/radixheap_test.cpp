@@ -0,0 +1,80 @@
+#include "yosupo/container/radixheap.hpp"
+
+#include <functional>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "yosupo/random.hpp"
+#include "yosupo/types.hpp"
+
+using namespace yosupo;
+
+TEST(RadixHeapTest, Usage) {
+    RadixHeapManager<u32, int> manager;
+    auto h = manager.build({{3, 0}, {1, 1}, {2, 2}});
+    ASSERT_EQ(3, h.size());
+    ASSERT_EQ(1, manager.top(h).second);
+    manager.pop(h);
+    manager.push(h, {2, 3});
+    ASSERT_EQ(2u, manager.top(h).first);
+    manager.pop(h);
+    ASSERT_EQ(2u, manager.top(h).first);
+    manager.pop(h);
+    ASSERT_EQ(3u, manager.top(h).first);
+    manager.pop(h);
+    ASSERT_TRUE(h.empty());
+}
+
+TEST(RadixHeapTest, Stress) {
+    for (int ph = 0; ph < 1000; ph++) {
+        RadixHeapManager<u8, int> manager;
+        using P = std::pair<u8, int>;
+        auto h0 = manager.build();
+        auto h1 = manager.build();
+        std::priority_queue<P, std::vector<P>, std::greater<P>> pq;
+        u8 last = 0;
+        for (int i = 0; i < 100; i++) {
+            int ty = uniform(0, 2);
+            if (ty == 0 || pq.empty()) {
+                P x = {u8(uniform<int>(last, 255)), i};
+                manager.push(uniform_bool() ? h0 : h1, x);
+                pq.push(x);
+            } else if (ty == 1) {
+                manager.meld(h0, h1);
+                ASSERT_TRUE(h1.empty());
+            } else {
+                manager.meld(h0, h1);
+                ASSERT_EQ(pq.top().first, manager.top(h0).first);
+                last = pq.top().first;
+                manager.pop(h0);
+                pq.pop();
+            }
+            ASSERT_EQ(pq.size(), h0.size() + h1.size());
+        }
+    }
+}
+
+TEST(RadixHeapTest, PopPush) {
+    RadixHeapManager<u32, int> manager;
+    auto h = manager.build({{3, 0}, {1, 1}});
+    manager.pop_push(h, {5, 2});
+    ASSERT_EQ(2, h.size());
+    ASSERT_EQ(3u, manager.top(h).first);
+    manager.pop_push(h, {4, 3});
+    ASSERT_EQ(4u, manager.top(h).first);
+    ASSERT_EQ(3, manager.top(h).second);
+}
+
+TEST(RadixHeapTest, Clear) {
+    RadixHeapManager<u32, int> manager;
+    auto h = manager.build({{10, 0}, {20, 1}});
+    manager.pop(h);
+    manager.top(h);
+    h.clear();
+    ASSERT_TRUE(h.empty());
+    // keys smaller than the last popped key are allowed again
+    manager.push(h, {1, 2});
+    ASSERT_EQ(1u, manager.top(h).first);
+}
@@ -21,3 +21,15 @@ TEST(SegTree2DTest, Usage) {
     seg.add({1, 2}, 100);
     EXPECT_EQ(seg.prod({0, 0}, {3, 3}), 111);
 }
+
+TEST(SegTree2DTest, Clear) {
+    SegTree2D seg({3, 3}, Sum<ll>(0));
+    seg.add({1, 2}, 1);
+    seg.add({2, 1}, 10);
+    seg.clear();
+    EXPECT_EQ(seg.all_prod(), 0);
+    EXPECT_EQ(seg.get({1, 2}), 0);
+    seg.add({0, 1}, 5);
+    EXPECT_EQ(seg.prod({0, 0}, {3, 3}), 5);
+    EXPECT_EQ(seg.get({0, 1}), 5);
+}
@@ -1,10 +1,13 @@
 #include "yosupo/container/sparsetable.hpp"
 
 #include <algorithm>
+#include <limits>
+#include <utility>
 #include <vector>
 
 #include "gtest/gtest.h"
 #include "yosupo/algebra.hpp"
+#include "yosupo/random.hpp"
 
 TEST(SparseTable, Usage) {
     yosupo::SparseTable<yosupo::Max<int>> sp(std::vector<int>{1, 3, 2});
@@ -18,3 +21,76 @@ TEST(SparseTable, Lambda) {
     ASSERT_EQ(sp.query(0, 3), 1);
     ASSERT_EQ(sp.query(0, 0), 12345);
 }
+
+TEST(SparseTable, Const) {
+    const yosupo::SparseTable<yosupo::Min<int>> sp(std::vector<int>{4, 3, 5});
+    ASSERT_EQ(sp.query(0, 3), 3);
+    ASSERT_EQ(sp.query(2, 3), 5);
+}
+
+TEST(SparseTable, NonConstOp) {
+    auto mo = yosupo::ReversibleMonoid(yosupo::Max<int>());
+    using S = decltype(mo)::S;
+    const yosupo::SparseTable sp(std::vector<S>{S(1), S(3), S(2)}, mo);
+    ASSERT_EQ(sp.query(0, 3).val, 3);
+    ASSERT_EQ(sp.query(2, 3).rev, 2);
+
+    const yosupo::SparseTable<yosupo::NoOpMonoid> sp2(
+        std::vector<yosupo::NoOpMonoid::S>(3));
+    sp2.query(0, 3);
+}
+
+TEST(SparseTable, Threads) {
+    int n = 1000;
+    std::vector<int> a(n);
+    for (int i = 0; i < n; i++) a[i] = yosupo::uniform(0, 1000);
+    yosupo::SparseTable<yosupo::Min<int>> sp1(a);
+    for (int threads : {2, 3, 8}) {
+        yosupo::SparseTable<yosupo::Min<int>> sp(a, {}, threads);
+        ASSERT_EQ(sp1.data, sp.data);
+    }
+}
+
+TEST(LinearSparseTable, Usage) {
+    const yosupo::LinearSparseTable<yosupo::Max<int>> sp(
+        std::vector<int>{1, 3, 2});
+    ASSERT_EQ(sp.query(0, 3), 3);
+    ASSERT_EQ(sp.query(2, 3), 2);
+    ASSERT_EQ(sp.query(1, 1), std::numeric_limits<int>::min());
+}
+
+TEST(LinearSparseTable, Lambda) {
+    yosupo::LinearSparseTable sp(
+        std::vector<int>{1, 3, 2},
+        yosupo::Monoid(12345, [](int a, int b) { return std::min(a, b); }));
+    ASSERT_EQ(sp.query(0, 3), 1);
+    ASSERT_EQ(sp.query(0, 0), 12345);
+}
+
+TEST(LinearSparseTable, Empty) {
+    yosupo::LinearSparseTable<yosupo::Min<int>> sp(std::vector<int>{});
+    ASSERT_EQ(sp.query(0, 0), std::numeric_limits<int>::max());
+}
+
+TEST(LinearSparseTable, Stress) {
+    for (int n : {1, 2, 63, 64, 65, 128, 200, 1000}) {
+        std::vector<int> a(n);
+        for (int i = 0; i < n; i++) a[i] = yosupo::uniform(0, 10);
+        int threads = yosupo::uniform(1, 4);
+        yosupo::LinearSparseTable<yosupo::Min<int>> sp_min(a, {}, threads);
+        yosupo::LinearSparseTable<yosupo::Max<int>> sp_max(a, {}, threads);
+        for (int ph = 0; ph < 1000; ph++) {
+            int l = yosupo::uniform(0, n);
+            int r = yosupo::uniform(0, n);
+            if (l > r) std::swap(l, r);
+            int mn = std::numeric_limits<int>::max();
+            int mx = std::numeric_limits<int>::min();
+            for (int i = l; i < r; i++) {
+                mn = std::min(mn, a[i]);
+                mx = std::max(mx, a[i]);
+            }
+            ASSERT_EQ(mn, sp_min.query(l, r));
+            ASSERT_EQ(mx, sp_max.query(l, r));
+        }
+    }
+}
@@ -1,11 +1,14 @@
 #include "yosupo/container/splaytree.hpp"
 
+#include <algorithm>
 #include <functional>
+#include <tuple>
 #include <utility>
 #include <vector>
 
 #include "gtest/gtest.h"
 #include "yosupo/algebra.hpp"
+#include "yosupo/random.hpp"
 
 struct RangeAddMax {
     using S = int;
@@ -142,3 +145,160 @@ TEST(SplayTreeTest, NoLazy) {
     tree.set(tr, 1, 10);
     EXPECT_EQ(tree.all_prod(tr), 10);
 }
+
+TEST(SplayTreeTest, Clear) {
+    yosupo::SplayTree tree((RangeAddMax()));
+    auto tr = tree.build({1, 2, 3, 4, 5});
+    auto tr2 = tree.build({6, 7});
+    tree.clear(tr);
+    EXPECT_TRUE(tr.empty());
+    for (int i = 0; i < 100; i++) {
+        tree.insert(tr2, 1, i);
+        tree.erase(tr2, 0);
+    }
+    EXPECT_EQ(std::vector<int>({99, 7}), tree.to_vec(tr2));
+
+    tree.reset();
+    auto tr3 = tree.build({8, 9});
+    EXPECT_EQ(std::vector<int>({8, 9}), tree.to_vec(tr3));
+}
+
+TEST(SplayTreeTest, Build) {
+    for (int n = 0; n < 100; n++) {
+        yosupo::SplayTree tree((RangeAddMax()));
+        std::vector<int> v(n);
+        for (int i = 0; i < n; i++) v[i] = yosupo::uniform(0, 100);
+        auto tr = tree.build(v);
+        EXPECT_EQ(v, tree.to_vec(tr));
+        EXPECT_EQ(n ? *std::max_element(v.begin(), v.end()) : 0,
+                  tree.all_prod(tr));
+    }
+}
+
+TEST(SplayTreeTest, Batch) {
+    for (int ph = 0; ph < 300; ph++) {
+        yosupo::SplayTree tree((RangeAddMax()));
+        std::vector<int> v(yosupo::uniform(0, 20));
+        for (auto& x : v) x = yosupo::uniform(0, 100);
+        auto tr = tree.build(v);
+
+        for (int step = 0; step < 10; step++) {
+            int n = int(v.size());
+            int ty = yosupo::uniform(0, 2);
+            if (ty == 0) {
+                std::vector<std::pair<int, int>> q(yosupo::uniform(0, 5));
+                for (auto& [k, x] : q) {
+                    k = yosupo::uniform(0, n);
+                    x = yosupo::uniform(0, 100);
+                }
+                std::stable_sort(q.begin(), q.end(), [](auto a, auto b) {
+                    return a.first < b.first;
+                });
+                std::vector<int> w;
+                int j = 0;
+                for (int i = 0; i <= n; i++) {
+                    while (j < int(q.size()) && q[j].first == i) {
+                        w.push_back(q[j++].second);
+                    }
+                    if (i < n) w.push_back(v[i]);
+                }
+                v = w;
+                tree.insert_batch(tr, q);
+            } else if (ty == 1) {
+                std::vector<int> ks;
+                std::vector<int> w;
+                for (int i = 0; i < n; i++) {
+                    if (yosupo::uniform_bool()) {
+                        ks.push_back(i);
+                    } else {
+                        w.push_back(v[i]);
+                    }
+                }
+                v = w;
+                tree.erase_batch(tr, ks);
+            } else {
+                std::vector<std::tuple<int, int, int>> q;
+                int l = 0;
+                while (true) {
+                    l = yosupo::uniform(l, n + 3);
+                    if (l > n) break;
+                    int r = yosupo::uniform(l, n);
+                    int f = yosupo::uniform(-10, 10);
+                    q.push_back({l, r, f});
+                    for (int i = l; i < r; i++) v[i] += f;
+                    l = r;
+                }
+                tree.apply_batch(tr, q);
+            }
+            ASSERT_EQ(v, tree.to_vec(tr));
+            int mx = 0;
+            for (int x : v) mx = std::max(mx, x);
+            ASSERT_EQ(mx, tree.all_prod(tr));
+        }
+    }
+}
+
+// few elements on a large tree, batches don't rebuild the tree
+TEST(SplayTreeTest, BatchSplit) {
+    int n = 1000;
+    yosupo::SplayTree tree((RangeAddMax()));
+    std::vector<int> v(n);
+    for (auto& x : v) x = yosupo::uniform(0, 100);
+    auto tr = tree.build(v);
+    for (int step = 0; step < 100; step++) {
+        n = int(v.size());
+        int ty = yosupo::uniform(0, 2);
+        if (ty == 0) {
+            std::vector<std::pair<int, int>> q(yosupo::uniform(1, 5));
+            for (auto& [k, x] : q) {
+                k = yosupo::uniform(0, n);
+                x = yosupo::uniform(0, 100);
+            }
+            std::stable_sort(q.begin(), q.end(), [](auto a, auto b) {
+                return a.first < b.first;
+            });
+            for (int i = int(q.size()) - 1; i >= 0; i--) {
+                v.insert(v.begin() + q[i].first, q[i].second);
+            }
+            tree.insert_batch(tr, q);
+        } else if (ty == 1) {
+            std::vector<int> ks;
+            for (int i = 0; i < 5; i++) ks.push_back(yosupo::uniform(0, n - 1));
+            std::ranges::sort(ks);
+            ks.erase(std::unique(ks.begin(), ks.end()), ks.end());
+            for (int i = int(ks.size()) - 1; i >= 0; i--) {
+                v.erase(v.begin() + ks[i]);
+            }
+            tree.erase_batch(tr, ks);
+        } else {
+            std::vector<std::tuple<int, int, int>> q;
+            int l = 0;
+            for (int i = 0; i < 5; i++) {
+                l = yosupo::uniform(l, n);
+                int r = yosupo::uniform(l, n);
+                int f = yosupo::uniform(-10, 10);
+                q.push_back({l, r, f});
+                for (int j = l; j < r; j++) v[j] += f;
+                l = r;
+            }
+            tree.apply_batch(tr, q);
+        }
+        ASSERT_EQ(v, tree.to_vec(tr));
+        ASSERT_EQ(*std::max_element(v.begin(), v.end()), tree.all_prod(tr));
+    }
+}
+
+TEST(SplayTreeTest, InsertBatchInvalid) {
+    auto unsorted = []() {
+        yosupo::SplayTree tree((RangeAddMax()));
+        auto tr = tree.build({1, 2, 3});
+        tree.insert_batch(tr, std::vector<std::pair<int, int>>{{2, 4}, {1, 5}});
+    };
+    EXPECT_DEATH(unsorted(), ".*");
+    auto too_large = []() {
+        yosupo::SplayTree tree((RangeAddMax()));
+        auto tr = tree.build({1, 2, 3});
+        tree.insert_batch(tr, std::vector<std::pair<int, int>>{{4, 4}});
+    };
+    EXPECT_DEATH(too_large(), ".*");
+}
@@ -0,0 +1,65 @@
+#include "yosupo/container/waveletmatrix.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "yosupo/random.hpp"
+#include "yosupo/types.hpp"
+
+using namespace yosupo;
+
+TEST(WaveletMatrixTest, Usage) {
+    WaveletMatrix<u32> wm(std::vector<u32>{3, 1, 4, 1, 5});
+    ASSERT_EQ(5, wm.size());
+    ASSERT_EQ(4u, wm.get(2));
+    ASSERT_EQ(1u, wm.kth_smallest(0, 5, 0));
+    ASSERT_EQ(3u, wm.kth_smallest(0, 5, 2));
+    ASSERT_EQ(5u, wm.kth_largest(0, 5, 0));
+    ASSERT_EQ(4u, wm.kth_largest(1, 4, 0));
+    ASSERT_EQ(3u, wm.quantile(0, 5, 0.5));
+    ASSERT_EQ(2, wm.freq(0, 5, 3u));
+    ASSERT_EQ(2, wm.freq(0, 5, 3u, 5u));
+    ASSERT_EQ(5, wm.freq(0, 5, 100u));
+}
+
+TEST(WaveletMatrixTest, Zero) {
+    WaveletMatrix<u32> wm(std::vector<u32>{0, 0});
+    ASSERT_EQ(0u, wm.get(1));
+    ASSERT_EQ(0u, wm.kth_smallest(0, 2, 1));
+    ASSERT_EQ(2, wm.freq(0, 2, 1u));
+    ASSERT_EQ(0, wm.freq(0, 2, 0u));
+
+    WaveletMatrix<u32> empty;
+    ASSERT_EQ(0, empty.size());
+}
+
+TEST(WaveletMatrixTest, Max) {
+    WaveletMatrix<u64> wm(std::vector<u64>{~0ULL, 0, ~0ULL - 1});
+    ASSERT_EQ(~0ULL, wm.kth_largest(0, 3, 0));
+    ASSERT_EQ(2, wm.freq(0, 3, ~0ULL));
+}
+
+TEST(WaveletMatrixTest, Stress) {
+    for (int n : {1, 2, 10, 100, 1000}) {
+        for (u32 upper : {1u, 7u, 1000u}) {
+            std::vector<u32> a(n);
+            for (auto& x : a) x = uniform(0u, upper);
+            WaveletMatrix<u32> wm(a);
+            for (int i = 0; i < n; i++) ASSERT_EQ(a[i], wm.get(i));
+            for (int ph = 0; ph < 300; ph++) {
+                int l = uniform(0, n - 1);
+                int r = uniform(l + 1, n);
+                std::vector<u32> b(a.begin() + l, a.begin() + r);
+                std::ranges::sort(b);
+                int k = uniform(0, r - l - 1);
+                ASSERT_EQ(b[k], wm.kth_smallest(l, r, k));
+                ASSERT_EQ(b[r - l - 1 - k], wm.kth_largest(l, r, k));
+                u32 lower = uniform(0u, upper + 1), up = uniform(0u, upper + 1);
+                int expected = int(std::ranges::count_if(
+                    b, [&](u32 x) { return lower <= x && x < up; }));
+                ASSERT_EQ(expected, wm.freq(l, r, lower, up));
+            }
+        }
+    }
+}
@@ -0,0 +1,187 @@
+#include "yosupo/container/wbtree.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "yosupo/algebra.hpp"
+#include "yosupo/random.hpp"
+
+using namespace yosupo;
+
+struct RangeAddMax {
+    using S = int;
+    using F = int;
+
+    Max<S> monoid = Max<S>(0);
+    Monoid<F, std::plus<F>> act = Monoid<F, std::plus<F>>(0);
+
+    S mapping(F l, S r) { return l + r; }
+};
+
+struct Concat {
+    struct S {
+        std::string val, rev;
+    };
+    struct Op {
+        S operator()(const S& a, const S& b) const {
+            return {a.val + b.val, b.rev + a.rev};
+        }
+    };
+    using F = int;
+
+    Monoid<S, Op> monoid = Monoid<S, Op>(S{});
+    Monoid<F, std::plus<F>> act = Monoid<F, std::plus<F>>(0);
+
+    // shift each character by f
+    S mapping(F f, S s) {
+        for (auto& c : s.val) c = char(c + f);
+        for (auto& c : s.rev) c = char(c + f);
+        return s;
+    }
+};
+
+TEST(WBTreeTest, Usage) {
+    WBTree tree((RangeAddMax()));
+    auto tr = tree.build({1, 2, 3, 4, 5});
+    EXPECT_EQ(5, tree.size(tr));
+    EXPECT_EQ(3, tree.get(tr, 2));
+    EXPECT_EQ(4, tree.prod(tr, 1, 4));
+    tree.apply(tr, 1, 3, 10);
+    EXPECT_EQ(std::vector<int>({1, 12, 13, 4, 5}), tree.to_vec(tr));
+    tree.insert(tr, 0, 100);
+    tree.erase(tr, 2);
+    EXPECT_EQ(std::vector<int>({100, 1, 13, 4, 5}), tree.to_vec(tr));
+    tree.reverse(tr, 1, 4);
+    EXPECT_EQ(std::vector<int>({100, 4, 13, 1, 5}), tree.to_vec(tr));
+}
+
+TEST(WBTreeTest, Stress) {
+    for (int ph = 0; ph < 100; ph++) {
+        WBTree tree((Concat()));
+        std::string s;
+        auto tr = tree.build();
+        for (int i = 0; i < 300; i++) {
+            int n = int(s.size());
+            int ty = uniform(0, 6);
+            int l = uniform(0, n), r = uniform(0, n);
+            if (l > r) std::swap(l, r);
+            if (ty == 0 || n == 0) {
+                char c = char('a' + uniform(0, 9));
+                tree.insert(tr, l, {std::string(1, c), std::string(1, c)});
+                s.insert(s.begin() + l, c);
+            } else if (ty == 1) {
+                int k = uniform(0, n - 1);
+                tree.erase(tr, k);
+                s.erase(s.begin() + k);
+            } else if (ty == 2) {
+                tree.reverse(tr, l, r);
+                std::reverse(s.begin() + l, s.begin() + r);
+            } else if (ty == 3) {
+                tree.apply(tr, l, r, 1);
+                for (int j = l; j < r; j++) s[j]++;
+            } else if (ty == 4) {
+                auto x = tree.prod(tr, l, r);
+                auto y = s.substr(l, r - l);
+                ASSERT_EQ(y, x.val);
+                std::reverse(y.begin(), y.end());
+                ASSERT_EQ(y, x.rev);
+            } else if (ty == 5) {
+                int k = uniform(0, n - 1);
+                ASSERT_EQ(std::string(1, s[k]), tree.get(tr, k).val);
+                char c = char('a' + uniform(0, 9));
+                tree.set(tr, k, {std::string(1, c), std::string(1, c)});
+                s[k] = c;
+            } else {
+                auto [t1, t2, t3] = tree.split3(std::move(tr), l, r);
+                tr = tree.merge3(std::move(t2), std::move(t1), std::move(t3));
+                s = s.substr(l, r - l) + s.substr(0, l) + s.substr(r);
+            }
+            ASSERT_EQ(s.size(), tree.size(tr));
+            ASSERT_EQ(s, tree.all_prod(tr).val);
+        }
+    }
+}
+
+TEST(WBTreeTest, Balanced) {
+    // each child has at most 3/4 of the weight (size + 1) of its parent
+    auto bound = [](int n) {
+        return int(std::log(n + 1) / std::log(4.0 / 3)) + 1;
+    };
+    WBTree tree((RangeAddMax()));
+    auto tr = tree.build();
+    for (int i = 0; i < 100000; i++) {
+        tree.insert(tr, i, i);
+        if (i % 1000 == 0) {
+            ASSERT_LE(tree.height(tr), bound(i + 1));
+        }
+    }
+    ASSERT_LE(tree.height(tr), bound(100000));
+    for (int i = 0; i < 1000; i++) {
+        int k = uniform(0, 99999);
+        ASSERT_EQ(k, tree.get(tr, k));
+    }
+
+    // random updates, and merges of very different sizes
+    for (int i = 0; i < 100000; i++) {
+        int n = int(tree.size(tr));
+        int ty = uniform(0, 3);
+        if (ty == 0) {
+            tree.insert(tr, uniform(0, n), i);
+        } else if (ty == 1) {
+            tree.erase(tr, uniform(0, n - 1));
+        } else if (ty == 2) {
+            int l = uniform(0, n), r = uniform(0, n);
+            if (l > r) std::swap(l, r);
+            tree.reverse(tr, l, r);
+        } else {
+            int l = std::min(n, uniform(0, 10));
+            int r = std::max(l, n - uniform(0, 10));
+            auto [t1, t2, t3] = tree.split3(std::move(tr), l, r);
+            tr = tree.merge3(std::move(t2), std::move(t3), std::move(t1));
+        }
+        if (i % 1000 == 0) {
+            ASSERT_LE(tree.height(tr), bound(int(tree.size(tr))));
+        }
+    }
+    tree.clear(tr);
+    EXPECT_TRUE(tr.empty());
+    EXPECT_EQ(0, tree.height(tr));
+}
+
+TEST(WBTreeTest, Persistent) {
+    PersistentWBTree tree((RangeAddMax()));
+    std::vector<std::vector<int>> vs = {{}};
+    std::vector<PersistentWBTree<RangeAddMax>::Tree> trs = {tree.build()};
+    for (int i = 0; i < 300; i++) {
+        int j = uniform(0, int(vs.size()) - 1);
+        auto v = vs[j];
+        auto tr = trs[j];
+        int n = int(v.size());
+        int ty = uniform(0, 3);
+        int l = uniform(0, n), r = uniform(0, n);
+        if (l > r) std::swap(l, r);
+        if (ty == 0 || n == 0) {
+            int x = uniform(0, 100);
+            tree.insert(tr, l, x);
+            v.insert(v.begin() + l, x);
+        } else if (ty == 1) {
+            tree.erase(tr, l % n);
+            v.erase(v.begin() + l % n);
+        } else if (ty == 2) {
+            tree.reverse(tr, l, r);
+            std::reverse(v.begin() + l, v.begin() + r);
+        } else {
+            tree.apply(tr, l, r, 1);
+            for (int k = l; k < r; k++) v[k]++;
+        }
+        vs.push_back(v);
+        trs.push_back(tr);
+    }
+    for (int i = 0; i < int(vs.size()); i++) {
+        ASSERT_EQ(vs[i], tree.to_vec(trs[i]));
+    }
+}
@@ -0,0 +1,114 @@
+#include "yosupo/countminsketch.hpp"
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "yosupo/random.hpp"
+#include "yosupo/types.hpp"
+
+using namespace yosupo;
+
+TEST(CountMinSketchTest, Usage) {
+    CountMinSketch<std::string> cms(8);
+    cms.add("a");
+    cms.add("a");
+    cms.add("b", 5);
+    EXPECT_LE(2, cms.estimate("a"));
+    EXPECT_LE(5, cms.estimate("b"));
+    EXPECT_LE(0, cms.estimate("c"));
+}
+
+TEST(CountMinSketchTest, Exact) {
+    // much wider than the number of keys
+    CountMinSketch<int> cms(16);
+    CountMinSketch<int> cons = cms;
+    for (int i = 0; i < 100; i++) {
+        cms.add(i, i);
+        cons.add_conservative(i, i);
+    }
+    for (int i = 0; i < 100; i++) {
+        EXPECT_EQ(u64(i), cms.estimate(i));
+        EXPECT_EQ(u64(i), cons.estimate(i));
+    }
+}
+
+TEST(CountMinSketchTest, UpperBound) {
+    CountMinSketch<int, 4> a(6), b = a, cons = a;
+    std::map<int, u64> cnt;
+    for (int i = 0; i < 10000; i++) {
+        int k = uniform(0, 1000);
+        (i % 2 ? a : b).add(k);
+        cons.add_conservative(k);
+        cnt[k]++;
+    }
+    a.merge(b);
+    for (auto [k, c] : cnt) {
+        EXPECT_LE(c, a.estimate(k));
+        EXPECT_LE(c, cons.estimate(k));
+        EXPECT_LE(cons.estimate(k), a.estimate(k));
+    }
+}
+
+TEST(CountMinSketchTest, MergeSeed) {
+    // built independently with the same seed
+    CountMinSketch<int> a(8, Hasher{1, 2}), b(8, Hasher{1, 2});
+    a.add(1, 3);
+    b.add(1, 4);
+    a.merge(b);
+    EXPECT_LE(7, a.estimate(1));
+
+    auto f = []() {
+        CountMinSketch<int> c(8), d(8);
+        c.merge(d);
+    };
+    EXPECT_DEATH(f(), ".*");
+    auto g = []() {
+        CountMinSketch<int> c(8, Hasher{1, 2}), d(8, Hasher{1, 3});
+        c.merge(d);
+    };
+    EXPECT_DEATH(g(), ".*");
+}
+
+TEST(SpaceSavingTest, Usage) {
+    SpaceSaving<int> ss(2);
+    ss.add(1, 10);
+    ss.add(2, 5);
+    ss.add(3);
+    auto top = ss.top();
+    ASSERT_EQ(2, top.size());
+    EXPECT_EQ(1, top[0].key);
+    EXPECT_EQ(10, top[0].count);
+    EXPECT_EQ(3, top[1].key);
+    EXPECT_EQ(6, top[1].count);
+    EXPECT_EQ(5, top[1].error);
+    EXPECT_EQ(6, ss.estimate(2));
+}
+
+TEST(SpaceSavingTest, HeavyHitters) {
+    SpaceSaving<int> a(20), b(20);
+    std::map<int, u64> cnt;
+    for (int i = 0; i < 100000; i++) {
+        // keys 0..4 are heavy
+        int k = uniform(0, 1) ? uniform(0, 4) : uniform(5, 100000);
+        (i % 2 ? a : b).add(k);
+        cnt[k]++;
+    }
+    for (auto* ss : {&a, &b}) {
+        for (const auto& e : ss->top()) {
+            EXPECT_LE(e.count - e.error, cnt[e.key]);
+        }
+    }
+    a.merge(b);
+    auto top = a.top();
+    std::vector<int> keys;
+    for (int i = 0; i < 5; i++) keys.push_back(top[i].key);
+    std::ranges::sort(keys);
+    EXPECT_EQ((std::vector<int>{0, 1, 2, 3, 4}), keys);
+    for (const auto& e : top) {
+        EXPECT_LE(e.count - e.error, cnt[e.key]);
+        EXPECT_LE(cnt[e.key], e.count);
+    }
+}
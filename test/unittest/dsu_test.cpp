@@ -1,6 +1,11 @@
 #include "yosupo/dsu.hpp"
 
+#include <thread>
+#include <utility>
+#include <vector>
+
 #include "gtest/gtest.h"
+#include "yosupo/random.hpp"
 
 TEST(DsuTest, Usage) {
     yosupo::RollbackDSU d(2);
@@ -24,3 +29,48 @@ TEST(DsuTest, Usage) {
     EXPECT_EQ(1, d.size(0));
     EXPECT_EQ(1, d.size(1));
 }
+
+TEST(DsuTest, ConcurrentUsage) {
+    yosupo::ConcurrentDSU d(3);
+    EXPECT_FALSE(d.same(0, 1));
+    EXPECT_TRUE(d.merge(0, 1));
+    EXPECT_FALSE(d.merge(1, 0));
+    EXPECT_TRUE(d.same(0, 1));
+    EXPECT_FALSE(d.same(0, 2));
+    EXPECT_EQ(d.leader(0), d.leader(1));
+}
+
+TEST(DsuTest, ConcurrentMultiThread) {
+    const int T = 4, N = 100000, M = 80000;
+    std::vector<std::pair<int, int>> edges(M);
+    for (auto& [a, b] : edges) {
+        a = yosupo::uniform(0, N - 1);
+        b = yosupo::uniform(0, N - 1);
+    }
+
+    yosupo::ConcurrentDSU d(N);
+    std::vector<int> merged(T);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < T; t++) {
+        threads.emplace_back([&, t] {
+            for (int i = t; i < M; i += T) {
+                merged[t] += d.merge(edges[i].first, edges[i].second);
+                d.same(edges[i].first, edges[M - 1 - i].second);
+            }
+        });
+    }
+    for (auto& th : threads) th.join();
+
+    yosupo::RollbackDSU expect(N);
+    int expect_merged = 0;
+    for (auto [a, b] : edges) {
+        expect_merged += !expect.same(a, b);
+        expect.merge(a, b);
+    }
+    int sum = 0;
+    for (int x : merged) sum += x;
+    ASSERT_EQ(expect_merged, sum);
+    for (int i = 0; i < N; i++) {
+        ASSERT_EQ(expect.same(0, i), d.same(0, i));
+    }
+}
@@ -0,0 +1,71 @@
+#include "yosupo/dynamicconnectivity.hpp"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "yosupo/random.hpp"
+
+using namespace yosupo;
+
+TEST(OfflineDynamicConnectivityTest, Usage) {
+    OfflineDynamicConnectivity dc(3);
+    dc.same(0, 1);
+    dc.add_edge(0, 1);
+    dc.add_edge(1, 2);
+    dc.same(0, 2);
+    dc.erase_edge(1, 0);
+    dc.same(0, 2);
+    dc.same(1, 2);
+    EXPECT_EQ(std::vector<bool>({false, true, false, true}), dc.solve());
+}
+
+TEST(OfflineDynamicConnectivityTest, Empty) {
+    OfflineDynamicConnectivity dc(3);
+    dc.add_edge(0, 1);
+    EXPECT_EQ(std::vector<bool>(), dc.solve());
+}
+
+TEST(OfflineDynamicConnectivityTest, Stress) {
+    for (int ph = 0; ph < 100; ph++) {
+        int n = uniform(1, 10);
+        OfflineDynamicConnectivity dc(n);
+        // multi edges and self loops are allowed
+        std::vector<std::pair<int, int>> edges;
+        std::vector<bool> expect;
+        for (int i = 0; i < 200; i++) {
+            int ty = uniform(0, 2);
+            int u = uniform(0, n - 1), v = uniform(0, n - 1);
+            if (ty == 0) {
+                dc.add_edge(u, v);
+                edges.push_back({u, v});
+            } else if (ty == 1 && !edges.empty()) {
+                int k = uniform(0, int(edges.size()) - 1);
+                std::swap(edges[k], edges.back());
+                auto [a, b] = edges.back();
+                edges.pop_back();
+                dc.erase_edge(b, a);
+            } else {
+                dc.same(u, v);
+                std::vector<int> vis(n);
+                std::vector<int> st = {u};
+                vis[u] = 1;
+                while (!st.empty()) {
+                    int x = st.back();
+                    st.pop_back();
+                    for (auto [a, b] : edges) {
+                        for (auto [s, t] : {std::pair(a, b), std::pair(b, a)}) {
+                            if (s == x && !vis[t]) {
+                                vis[t] = 1;
+                                st.push_back(t);
+                            }
+                        }
+                    }
+                }
+                expect.push_back(vis[v]);
+            }
+        }
+        ASSERT_EQ(expect, dc.solve());
+    }
+}
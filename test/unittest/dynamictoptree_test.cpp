@@ -0,0 +1,131 @@
+#include "yosupo/dynamictoptree.hpp"
+
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "yosupo/algebra.hpp"
+#include "yosupo/random.hpp"
+#include "yosupo/types.hpp"
+
+using yosupo::u64;
+
+// h(u) = v_u + K * sum h(children)
+struct TreeHashDP {
+    static constexpr u64 K = 1000003;
+
+    using Point = u64;
+    // x -> a * x + b
+    using Path = std::pair<u64, u64>;
+    using Vertex = u64;
+
+    struct Compose {
+        Path operator()(const Path& l, const Path& r) const {
+            return {l.first * r.first, l.first * r.second + l.second};
+        }
+    };
+
+    yosupo::Sum<Point> point = yosupo::Sum<Point>(0);
+    yosupo::Monoid<Path, Compose> path =
+        yosupo::Monoid<Path, Compose>(Path(1, 0));
+
+    Path add_vertex(Point x, Vertex v) { return {K, v + K * x}; }
+    Point add_edge(Path x) { return x.second; }
+};
+
+TEST(DynamicTopTree, Usage) {
+    yosupo::DynamicTopTree<TreeHashDP> tt(std::vector<u64>{1, 2, 3});
+    tt.link(1, 0);
+    tt.link(2, 1);
+    // 0 - 1 - 2
+    auto K = TreeHashDP::K;
+    EXPECT_EQ(1 + K * (2 + K * 3), tt.all_prod(0));
+    tt.evert(2);
+    EXPECT_EQ(3 + K * (2 + K * 1), tt.all_prod(0));
+    EXPECT_EQ(2 + K * 1, tt.subtree_prod(1));
+    tt.cut(1, 2);
+    EXPECT_EQ(3u, tt.all_prod(2));
+    EXPECT_EQ(1, tt.root(0));
+}
+
+TEST(DynamicTopTree, Stress) {
+    for (int ph = 0; ph < 100; ph++) {
+        int n = yosupo::uniform(1, 30);
+        std::vector<u64> v(n);
+        for (auto& x : v) x = yosupo::uniform<u64>(0, -1);
+        yosupo::DynamicTopTree<TreeHashDP> tt(v);
+        std::vector<std::vector<int>> g(n);
+
+        auto erase_edge = [&](int a, int b) {
+            std::erase(g[a], b);
+            std::erase(g[b], a);
+        };
+        // parent of each vertex when rooted at r, and the dfs order
+        auto rooted = [&](int r) {
+            std::vector<int> par(n, -1), order = {r};
+            for (int i = 0; i < int(order.size()); i++) {
+                int u = order[i];
+                for (int w : g[u]) {
+                    if (w == par[u]) continue;
+                    par[w] = u;
+                    order.push_back(w);
+                }
+            }
+            return std::pair{par, order};
+        };
+        auto hash = [&](const std::vector<int>& par,
+                        const std::vector<int>& order) {
+            std::vector<u64> h(n);
+            for (int i = int(order.size()) - 1; i >= 0; i--) {
+                int u = order[i];
+                h[u] += v[u];
+                if (par[u] != -1) h[par[u]] += TreeHashDP::K * h[u];
+            }
+            return h;
+        };
+
+        for (int q = 0; q < 100; q++) {
+            int ty = yosupo::uniform(0, 3);
+            int a = yosupo::uniform(0, n - 1), b = yosupo::uniform(0, n - 1);
+            auto [par, order] = rooted(a);
+            bool connected = false;
+            for (int u : order) connected |= (u == b);
+            if (ty == 0) {
+                if (connected) continue;
+                tt.link(a, b);
+                g[a].push_back(b);
+                g[b].push_back(a);
+            } else if (ty == 1) {
+                if (g[a].empty()) continue;
+                b = g[a][yosupo::uniform(0, int(g[a].size()) - 1)];
+                tt.cut(a, b);
+                erase_edge(a, b);
+            } else if (ty == 2) {
+                u64 x = yosupo::uniform<u64>(0, -1);
+                tt.update(a, x);
+                v[a] = x;
+            } else {
+                if (!connected) continue;
+                auto h = hash(par, order);
+                // path a -> b, b's subtree is folded into b
+                TreeHashDP dp;
+                TreeHashDP::Path expect = dp.path.e;
+                int next = -1;
+                for (int u = b; u != -1; next = u, u = par[u]) {
+                    u64 point = 0;
+                    for (int w : g[u]) {
+                        if (w != par[u] && w != next) point += h[w];
+                    }
+                    expect = dp.path.op(dp.add_vertex(point, v[u]), expect);
+                }
+                int r = tt.root(a);
+                ASSERT_EQ(expect, tt.path_prod(a, b));
+                ASSERT_EQ(r, tt.root(b));
+                tt.evert(a);
+                ASSERT_EQ(h[a], tt.all_prod(b));
+                ASSERT_EQ(h[b], tt.subtree_prod(b));
+                ASSERT_EQ(a, tt.root(b));
+            }
+        }
+    }
+}
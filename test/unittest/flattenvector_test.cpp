@@ -1,9 +1,13 @@
 #include "yosupo/flattenvector.hpp"
 
+#include <algorithm>
+#include <functional>
+#include <memory>
 #include <utility>
 #include <vector>
 
 #include "gtest/gtest.h"
+#include "yosupo/random.hpp"
 #include "yosupo/util.hpp"
 
 using namespace yosupo;
@@ -46,3 +50,80 @@ TEST(FlattenVectorTest, EraseIf) {
     EXPECT_EQ(v.start, std::vector({0, 0, 0, 0}));
     EXPECT_EQ(v.v, std::vector<int>());
 }
+
+TEST(FlattenVectorTest, Move) {
+    std::vector<std::pair<int, std::vector<int>>> rows = {
+        {1, {1, 2}}, {0, {3}}, {1, {4}}};
+    FlattenVector v(2, std::move(rows));
+    ASSERT_EQ(v.start, std::vector({0, 1, 3}));
+    ASSERT_EQ(v.v, std::vector<std::vector<int>>({{3}, {1, 2}, {4}}));
+}
+
+TEST(FlattenVectorTest, Generator) {
+    // row i has the divisors of i
+    int n = 10;
+    FlattenVector<int> v(n, [&](auto f) {
+        for (int d = 1; d < n; d++) {
+            for (int i = d; i < n; i += d) f(i, d);
+        }
+    });
+    ASSERT_EQ(to_vec(v.at(0)), std::vector<int>());
+    ASSERT_EQ(to_vec(v.at(6)), std::vector({1, 2, 3, 6}));
+    ASSERT_EQ(to_vec(v.at(7)), std::vector({1, 7}));
+}
+
+TEST(FlattenVectorTest, SortRows) {
+    FlattenVector v(3, std::vector<std::pair<int, int>>(
+                           {{0, 2}, {0, 1}, {1, 11}, {2, 20}, {1, 10}}));
+    v.sort_rows();
+    ASSERT_EQ(v.v, std::vector({1, 2, 10, 11, 20}));
+    v.sort_rows(std::greater<>());
+    ASSERT_EQ(v.v, std::vector({2, 1, 11, 10, 20}));
+
+    // at returns a span
+    v.at(1)[0] = 100;
+    ASSERT_EQ(100, v.v[2]);
+    ASSERT_EQ(2u, v.at(1).size());
+}
+
+TEST(FlattenVectorTest, Threads) {
+    int n = 100;
+    std::vector<std::pair<int, int>> a(1000);
+    for (auto& [i, x] : a) {
+        i = uniform(0, n - 1);
+        x = uniform(0, 1000000);
+    }
+    FlattenVector<int> v0(n, a);
+    for (int threads : {1, 2, 3, 8}) {
+        FlattenVector<int> v1(n, a, threads);
+        ASSERT_EQ(v0.start, v1.start);
+        ASSERT_EQ(v0.v, v1.v);
+        FlattenVector<int> v2(n, std::vector(a), threads);
+        ASSERT_EQ(v0.start, v2.start);
+        ASSERT_EQ(v0.v, v2.v);
+        // part t emits a[i] for i = t, t + threads, ...
+        FlattenVector<int> v3(
+            n,
+            [&](int t, auto f) {
+                for (int i = t; i < int(a.size()); i += threads) {
+                    f(a[i].first, a[i].second);
+                }
+            },
+            threads);
+        ASSERT_EQ(v0.start, v3.start);
+        for (int i = 0; i < n; i++) {
+            auto r0 = to_vec(v0.at(i)), r3 = to_vec(v3.at(i));
+            std::ranges::sort(r0);
+            std::ranges::sort(r3);
+            ASSERT_EQ(r0, r3);
+        }
+    }
+
+    // rows of move-only values
+    std::vector<std::pair<int, std::unique_ptr<int>>> b;
+    for (int i = 0; i < 10; i++) b.push_back({i % 3, std::make_unique<int>(i)});
+    FlattenVector v4(3, std::move(b), 2);
+    ASSERT_EQ(v4.start, std::vector({0, 4, 7, 10}));
+    ASSERT_EQ(9, *v4.v[3]);
+    ASSERT_EQ(8, *v4.v[9]);
+}
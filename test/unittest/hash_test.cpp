@@ -4,6 +4,7 @@
 #include <limits>
 #include <map>
 #include <set>
+#include <span>
 #include <string>
 #include <tuple>
 #include <unordered_map>
@@ -168,3 +169,62 @@ TEST(HashTest, UnorderedMap) {
     EXPECT_TRUE(m.contains("abc"));
     EXPECT_FALSE(m.contains("cba"));
 }
+
+TEST(HashTest, String) {
+    Hasher h;
+
+    std::set<u64> hashes;
+    std::string s;
+    for (int i = 0; i < 100; i++) {
+        EXPECT_EQ(h(s), h(std::string(s)));
+        hashes.insert(h(s));
+        s += 'a';
+    }
+    // trailing zeros must change the hash
+    s = "";
+    for (int i = 0; i < 100; i++) {
+        hashes.insert(h(s));
+        s += '\0';
+    }
+    EXPECT_EQ(199, hashes.size());
+}
+
+TEST(HashTest, StringHashQuality) {
+    Hasher h;
+
+    std::set<u64> hashes;
+    for (int i = 0; i < 100; i++) {
+        std::string s(100, 'a');
+        s[i] = 'b';
+        hashes.insert(h(s));
+    }
+    EXPECT_EQ(100, hashes.size());
+}
+
+TEST(HashTest, VectorHashQuality) {
+    Hasher h;
+
+    std::set<u64> hashes;
+    for (int i = 0; i < 100; i++) {
+        std::vector<int> v(100);
+        v[i] = 1;
+        hashes.insert(h(v));
+        v[i] = -1;
+        hashes.insert(h(v));
+    }
+    EXPECT_EQ(200, hashes.size());
+}
+
+TEST(HashTest, Batch) {
+    Hasher h;
+
+    std::vector<i32> a = {1, -2, 3, -4, 5, 6, 7};
+    std::vector<u64> out(a.size());
+    h.hash_batch(std::span<const i32>(a), std::span<u64>(out));
+    for (size_t i = 0; i < a.size(); i++) EXPECT_EQ(h(a[i]), out[i]);
+
+    std::vector<std::string> b = {"", "a", std::string(100, 'x')};
+    std::vector<u64> out2(b.size());
+    h.hash_batch(std::span<const std::string>(b), std::span<u64>(out2));
+    for (size_t i = 0; i < b.size(); i++) EXPECT_EQ(h(b[i]), out2[i]);
+}
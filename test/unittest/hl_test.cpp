@@ -1,9 +1,14 @@
 #include "yosupo/hl.hpp"
 
+#include <algorithm>
 #include <utility>
+#include <vector>
 
 #include "gtest/gtest.h"
+#include "yosupo/algebra.hpp"
+#include "yosupo/random.hpp"
 #include "yosupo/tree.hpp"
+#include "yosupo/types.hpp"
 
 using namespace yosupo;
 
@@ -26,3 +31,137 @@ TEST(HLTest, N1) {
     RootedTreeBuilder tree(1);
     HLEulerTour hl(std::move(tree).build(0));
 }
+
+TEST(HLTest, PathRanges) {
+    // 0 - 1 - 2, 1 - 3
+    RootedTreeBuilder tree(4);
+    tree.add_edge(0, 1);
+    tree.add_edge(1, 2);
+    tree.add_edge(1, 3);
+    HLEulerTour hl(std::move(tree).build(0));
+
+    std::vector<int> path;
+    for (auto [l, r, rev] : hl.path_ranges(2, 3)) {
+        for (int i = 0; i < r - l; i++) {
+            path.push_back(hl.rord[rev ? r - 1 - i : l + i]);
+        }
+    }
+    EXPECT_EQ(std::vector<int>({2, 1, 3}), path);
+
+    auto [l, r] = hl.subtree_range(1);
+    EXPECT_EQ(hl.ord[1], l);
+    EXPECT_EQ(3, r - l);
+}
+
+TEST(HLTest, PathQuery) {
+    // x -> a * x + b
+    using Path = std::pair<u64, u64>;
+    struct Compose {
+        Path operator()(const Path& l, const Path& r) const {
+            return {l.first * r.first, l.first * r.second + l.second};
+        }
+    };
+    using M = Monoid<Path, Compose>;
+
+    for (int ph = 0; ph < 100; ph++) {
+        int n = uniform(1, 50);
+        RootedTreeBuilder tree(n);
+        std::vector<int> par(n, -1);
+        for (int i = 1; i < n; i++) {
+            par[i] = uniform(0, i - 1);
+            tree.add_edge(par[i], i);
+        }
+        std::vector<Path> v(n);
+        for (auto& x : v) x = {uniform<u64>(0, -1), uniform<u64>(0, -1)};
+        HLPathQuery pq(std::move(tree).build(0), v, M(Path(1, 0)));
+
+        auto depth = [&](int u) {
+            int d = 0;
+            while (par[u] != -1) u = par[u], d++;
+            return d;
+        };
+        for (int q = 0; q < 100; q++) {
+            int u = uniform(0, n - 1), w = uniform(0, n - 1);
+            if (uniform_bool()) {
+                Path x = {uniform<u64>(0, -1), uniform<u64>(0, -1)};
+                pq.set(u, x);
+                v[u] = x;
+                continue;
+            }
+            // u -> lca, lca <- w
+            std::vector<int> up, down;
+            int a = u, b = w;
+            while (a != b) {
+                if (depth(a) >= depth(b)) {
+                    up.push_back(a);
+                    a = par[a];
+                } else {
+                    down.push_back(b);
+                    b = par[b];
+                }
+            }
+            up.push_back(a);
+            up.insert(up.end(), down.rbegin(), down.rend());
+            Path expect = {1, 0};
+            for (int x : up) expect = Compose()(expect, v[x]);
+            ASSERT_EQ(expect, pq.prod(u, w));
+            ASSERT_EQ(v[u], pq.get(u));
+
+            // subtree_range is exactly the subtree of u
+            auto [l, r] = pq.hl.subtree_range(u);
+            std::vector<int> sub, sub2;
+            for (int x = 0; x < n; x++) {
+                int y = x;
+                while (y != -1 && y != u) y = par[y];
+                if (y == u) sub.push_back(x);
+            }
+            for (int i = l; i < r; i++) sub2.push_back(pq.hl.rord[i]);
+            std::ranges::sort(sub2);
+            ASSERT_EQ(sub, sub2);
+
+            // subtree_prod folds the subtree in ord
+            Path sub_expect = {1, 0};
+            for (int i = l; i < r; i++) {
+                sub_expect = Compose()(sub_expect, v[pq.hl.rord[i]]);
+            }
+            ASSERT_EQ(sub_expect, pq.subtree_prod(u));
+        }
+    }
+}
+
+TEST(HLTest, LCA) {
+    for (int ph = 0; ph < 100; ph++) {
+        int n = uniform(1, 100);
+        RootedTreeBuilder builder(n);
+        std::vector<int> par(n, -1), depth(n);
+        for (int i = 1; i < n; i++) {
+            par[i] = uniform(std::max(0, i - 3), i - 1);
+            depth[i] = depth[par[i]] + 1;
+            builder.add_edge(par[i], i);
+        }
+        auto tree = std::move(builder).build(0);
+        HLEulerTour hl(tree), hl_rmq(tree, true);
+
+        std::vector<std::pair<int, int>> qs(300);
+        std::vector<int> expect;
+        for (auto& [u, v] : qs) {
+            u = uniform(0, n - 1);
+            v = uniform(0, n - 1);
+            int a = u, b = v;
+            while (a != b) {
+                if (depth[a] >= depth[b]) {
+                    a = par[a];
+                } else {
+                    b = par[b];
+                }
+            }
+            expect.push_back(a);
+        }
+        for (int i = 0; i < int(qs.size()); i++) {
+            ASSERT_EQ(expect[i], hl.lca(qs[i].first, qs[i].second));
+            ASSERT_EQ(expect[i], hl_rmq.lca(qs[i].first, qs[i].second));
+        }
+        ASSERT_EQ(expect, hl.lca_batch(qs));
+        ASSERT_EQ(expect, hl_rmq.lca_batch(qs));
+    }
+}
@@ -1,5 +1,8 @@
 #include "yosupo/hyperloglog.hpp"
 
+#include <thread>
+#include <vector>
+
 #include "gtest/gtest.h"
 #include "yosupo/random.hpp"
 #include "yosupo/types.hpp"
@@ -28,3 +31,107 @@ TEST(HyperLogLogTest, Linear) {
         ASSERT_EQ(est, n);
     }
 }
+
+TEST(HyperLogLogTest, Duplicate) {
+    HyperLogLog<4, 10> hll;
+    for (int ph = 0; ph < 3; ph++) {
+        for (u32 i = 0; i < 10; i++) hll.add(i * 12345);
+    }
+    ASSERT_EQ(10, hll.estimate());
+}
+
+TEST(HyperLogLogTest, Merge) {
+    HyperLogLog<10, 100> a, b, all;
+    for (int i = 0; i < 5000; i++) {
+        u32 x = uniform<u32>(0, -1);
+        (i % 2 ? a : b).add(x);
+        all.add(x);
+    }
+    HyperLogLog<10, 100> c = a;
+    c.merge(b);
+    ASSERT_EQ(all.estimate(), c.estimate());
+    ASSERT_EQ(all.estimate(), (a + b).estimate());
+
+    HyperLogLog<10, 100> small;
+    small.add(1);
+    small.add(2);
+    c = a;
+    c.merge(small);
+    a.add(1);
+    a.add(2);
+    ASSERT_EQ(a.estimate(), c.estimate());
+    small.merge(a);
+    ASSERT_EQ(a.estimate(), small.estimate());
+}
+
+TEST(HyperLogLogTest, Serialize) {
+    for (int n : {0, 1, 50, 100, 101, 10000}) {
+        HyperLogLog<8, 100> hll;
+        for (int i = 0; i < n; i++) hll.add(uniform<u32>(0, -1));
+        if (n) hll.add(0);
+        auto data = hll.serialize();
+        auto hll2 = HyperLogLog<8, 100>::deserialize(data);
+        ASSERT_TRUE(hll2);
+        ASSERT_EQ(hll.estimate(), hll2->estimate());
+        ASSERT_EQ(data, hll2->serialize());
+    }
+    HyperLogLog<8, 0> dense;
+    dense.add(123);
+    ASSERT_EQ(6 + 256 * 6 / 8, dense.serialize().size());
+}
+
+TEST(HyperLogLogTest, DeserializeInvalid) {
+    for (int n : {0, 3, 1000}) {
+        HyperLogLog<8, 10> hll;
+        for (int i = 0; i < n; i++) hll.add(uniform<u32>(0, -1));
+        auto data = hll.serialize();
+        // truncated
+        for (size_t len = 0; len < data.size(); len++) {
+            ASSERT_FALSE((HyperLogLog<8, 10>::deserialize(
+                std::span(data).first(len))));
+        }
+        // trailing bytes
+        auto longer = data;
+        longer.push_back(0);
+        ASSERT_FALSE((HyperLogLog<8, 10>::deserialize(longer)));
+        // other B or PLUS
+        ASSERT_FALSE((HyperLogLog<9, 10>::deserialize(data)));
+        ASSERT_FALSE((HyperLogLog<8, 11>::deserialize(data)));
+        ASSERT_FALSE((HyperLogLog<8, 0>::deserialize(data)));
+        // unknown type
+        auto bad = data;
+        bad[0] = 2;
+        ASSERT_FALSE((HyperLogLog<8, 10>::deserialize(bad)));
+    }
+
+    // small set larger than PLUS
+    HyperLogLog<8, 20> big;
+    for (u32 i = 1; i <= 20; i++) big.add(i);
+    auto data = big.serialize();
+    data[2] = 10;
+    ASSERT_FALSE((HyperLogLog<8, 10>::deserialize(data)));
+
+    // register larger than 33
+    HyperLogLog<4, 0> dense;
+    dense.add(1);
+    data = dense.serialize();
+    ASSERT_TRUE((HyperLogLog<4, 0>::deserialize(data)));
+    data[6] = 63;
+    ASSERT_FALSE((HyperLogLog<4, 0>::deserialize(data)));
+}
+
+TEST(HyperLogLogTest, Concurrent) {
+    ConcurrentHyperLogLog<8> chll;
+    HyperLogLog<8> hll;
+    std::vector<u32> hashes(10000);
+    for (auto& x : hashes) x = uniform<u32>(0, -1);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([&, t] {
+            for (size_t i = t; i < hashes.size(); i += 4) chll.add(hashes[i]);
+        });
+    }
+    for (auto& th : threads) th.join();
+    for (auto x : hashes) hll.add(x);
+    ASSERT_EQ(hll.estimate(), chll.estimate());
+}
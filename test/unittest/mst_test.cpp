@@ -3,6 +3,7 @@
 #include <vector>
 
 #include "gtest/gtest.h"
+#include "yosupo/random.hpp"
 
 using namespace yosupo;
 
@@ -15,3 +16,18 @@ TEST(MSTTest, Usage) {
     ASSERT_EQ(result.first, 5);
     ASSERT_EQ(result.second, std::vector<int>({0, 2}));
 }
+
+TEST(MSTTest, Methods) {
+    for (int ph = 0; ph < 100; ph++) {
+        int n = uniform(1, 30), m = uniform(0, 3000);
+        MST<int> mst(n);
+        for (int i = 0; i < m; i++) {
+            // many ties and self loops, maybe disconnected
+            mst.add_edge(uniform(0, n - 1), uniform(0, n - 1), uniform(0, 5));
+        }
+        auto expect = mst.mst();
+        ASSERT_EQ(expect, mst.mst_filter_kruskal());
+        ASSERT_EQ(expect, mst.mst_boruvka());
+        ASSERT_EQ(expect, mst.mst_boruvka(3));
+    }
+}
@@ -1,11 +1,14 @@
 #include "yosupo/toptree.hpp"
 
+#include <algorithm>
 #include <utility>
 #include <vector>
 
 #include "gtest/gtest.h"
 #include "yosupo/algebra.hpp"
+#include "yosupo/random.hpp"
 #include "yosupo/tree.hpp"
+#include "yosupo/types.hpp"
 
 struct TopTreeDP {
     using Point = int;
@@ -46,3 +49,66 @@ TEST(StaticTopTree, AllProd) {
     auto all = top_tree.all_prod();
     EXPECT_EQ(all, 5);
 }
+
+// h(u) = v_u + K * sum h(children)
+struct TreeHashDP {
+    static constexpr yosupo::u64 K = 1000003;
+
+    using Point = yosupo::u64;
+    // x -> a * x + b
+    using Path = std::pair<yosupo::u64, yosupo::u64>;
+    using Vertex = yosupo::u64;
+
+    struct Compose {
+        Path operator()(const Path& l, const Path& r) const {
+            return {l.first * r.first, l.first * r.second + l.second};
+        }
+    };
+
+    yosupo::Sum<Point> point = yosupo::Sum<Point>(0);
+    yosupo::Monoid<Path, Compose> path =
+        yosupo::Monoid<Path, Compose>(Path(1, 0));
+
+    Path add_vertex(Point x, Vertex v) { return {K, v + K * x}; }
+    Point add_edge(Path x) { return x.second; }
+};
+
+TEST(StaticTopTree, UpdateBatch) {
+    for (int ph = 0; ph < 100; ph++) {
+        int n = yosupo::uniform(1, 200);
+        int w = yosupo::uniform(1, n);
+        std::vector<int> par(n, -1);
+        yosupo::RootedTreeBuilder builder(n);
+        for (int i = 1; i < n; i++) {
+            par[i] = yosupo::uniform(std::max(0, i - w), i - 1);
+            builder.add_edge(par[i], i);
+        }
+        auto tree = std::move(builder).build(0);
+        std::vector<yosupo::u64> v(n);
+        yosupo::StaticTopTree<TreeHashDP> tt0(tree, v), tt1(tree, v);
+        int threads = yosupo::uniform(1, 4);
+
+        for (int q = 0; q < 10; q++) {
+            std::vector<std::pair<int, yosupo::u64>> updates(
+                yosupo::uniform(0, n));
+            for (auto& [u, x] : updates) {
+                u = yosupo::uniform(0, n - 1);
+                x = yosupo::uniform<yosupo::u64>(0, -1);
+                tt0.update(u, x);
+                v[u] = x;
+            }
+            tt1.update_batch(updates, threads);
+
+            std::vector<yosupo::u64> h(n);
+            for (int u = n - 1; u >= 0; u--) {
+                h[u] += v[u];
+                if (u) h[par[u]] += TreeHashDP::K * h[u];
+            }
+            ASSERT_EQ(h[0], tt0.all_prod());
+            ASSERT_EQ(h[0], tt1.all_prod());
+            for (int u = 0; u < n; u++) {
+                ASSERT_EQ(tt0.path_prod(u), tt1.path_prod(u));
+            }
+        }
+    }
+}
@@ -0,0 +1,84 @@
+#include "yosupo/tree.hpp"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "yosupo/random.hpp"
+#include "yosupo/util.hpp"
+
+using namespace yosupo;
+
+TEST(TreeTest, Usage) {
+    RootedTreeBuilder builder(4);
+    builder.add_edge(0, 1);
+    builder.add_edge(1, 2);
+    builder.add_edge(1, 3);
+    auto tree = std::move(builder).build(1);
+    EXPECT_EQ(1, tree.root);
+    EXPECT_EQ(std::vector<int>({1, -1, 1, 1}), tree.par);
+    EXPECT_EQ(std::vector<int>({0, 2, 3}), to_vec(tree.children.at(1)));
+    EXPECT_EQ(1, tree.topo[0]);
+}
+
+TEST(TreeTest, N1) {
+    auto tree = RootedTreeBuilder(1).build(0);
+    EXPECT_EQ(std::vector<int>({0}), tree.topo);
+    EXPECT_EQ(std::vector<int>({-1}), tree.par);
+}
+
+TEST(TreeTest, Stress) {
+    for (int ph = 0; ph < 100; ph++) {
+        int n = uniform(1, 100);
+        // random tree with shuffled labels
+        std::vector<int> perm(n);
+        for (int i = 0; i < n; i++) perm[i] = i;
+        std::shuffle(perm.begin(), perm.end(), global_gen());
+        std::vector<std::pair<int, int>> edges;
+        for (int i = 1; i < n; i++) {
+            edges.push_back({perm[uniform(0, i - 1)], perm[i]});
+        }
+        int root = uniform(0, n - 1);
+
+        int threads = uniform(1, 4);
+
+        RootedTreeBuilder builder(n);
+        for (auto [u, v] : edges) builder.add_edge(u, v);
+        auto tree = std::move(builder).build(root, threads);
+
+        ASSERT_EQ(n, tree.n);
+        ASSERT_EQ(root, tree.root);
+        ASSERT_EQ(-1, tree.par[root]);
+        for (auto [u, v] : edges) {
+            ASSERT_TRUE(tree.par[u] == v || tree.par[v] == u);
+        }
+        std::vector<int> pos(n, -1);
+        for (int i = 0; i < n; i++) pos[tree.topo[i]] = i;
+        for (int u = 0; u < n; u++) {
+            ASSERT_NE(-1, pos[u]);
+            if (u != root) {
+                ASSERT_LT(pos[tree.par[u]], pos[u]);
+            }
+            for (int v : tree.children.at(u)) ASSERT_EQ(u, tree.par[v]);
+        }
+
+        auto tree2 = rooted_tree_from_par(tree.par);
+        ASSERT_EQ(tree.children.v, tree2.children.v);
+        ASSERT_EQ(tree.children.start, tree2.children.start);
+        for (int u = 0; u < n; u++) {
+            ASSERT_TRUE(std::ranges::is_sorted(tree2.children.at(u)));
+        }
+        auto tree3 = rooted_tree_from_par(tree.par, threads);
+        ASSERT_EQ(tree2.children.v, tree3.children.v);
+        ASSERT_EQ(tree2.children.start, tree3.children.start);
+        ASSERT_EQ(tree2.topo, tree3.topo);
+        // bfs order
+        std::vector<int> depth(n);
+        for (int i = 1; i < n; i++) {
+            int u = tree2.topo[i];
+            depth[u] = depth[tree2.par[u]] + 1;
+            ASSERT_LE(depth[tree2.topo[i - 1]], depth[u]);
+        }
+    }
+}